@@ -0,0 +1,60 @@
+/**
+ * @file bench_color.c
+ * @brief Mede no host o débito dos kernels RGB888/ARGB8888 -> RGB565
+ *
+ * Converte repetidamente linhas de 160 pixels (largura do ecrã) e compara
+ * o resultado com o débito do SPI a 8 MHz (16 bits por pixel).
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "st7735_color.h"
+
+#define ROW_PIXELS  160
+#define ROWS        200000
+#define SPI_HZ      (8 * 1000 * 1000)
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void report(const char *name, double secs, uint32_t checksum) {
+    double mpx = (double)ROWS * ROW_PIXELS / secs / 1e6;
+    double spi_mpx = SPI_HZ / 16.0 / 1e6;
+    printf("%-22s %8.1f Mpx/s  (%6.0fx o SPI a %d MHz)  [checksum %08x]\n",
+           name, mpx, mpx / spi_mpx, SPI_HZ / 1000000, (unsigned)checksum);
+}
+
+int main(void) {
+    static uint8_t rgb[ROW_PIXELS * 3];
+    static uint32_t argb[ROW_PIXELS];
+    static uint8_t dst[ROW_PIXELS * 2];
+
+    // Gradiente com alfa variável: exercita os ramos opaco, transparente e misturado
+    for (int i = 0; i < ROW_PIXELS; i++) {
+        rgb[i*3] = i * 255 / (ROW_PIXELS - 1);
+        rgb[i*3+1] = 255 - rgb[i*3];
+        rgb[i*3+2] = (i * 7) & 0xFF;
+        argb[i] = ((uint32_t)(i * 255 / (ROW_PIXELS - 1)) << 24) | (rgb[i*3] << 16) | (rgb[i*3+1] << 8) | rgb[i*3+2];
+    }
+
+    uint32_t sum = 0;
+    double t0 = now_s();
+    for (uint32_t r = 0; r < ROWS; r++) {
+        st7735_rgb888_to_rgb565_row(dst, rgb, ROW_PIXELS, r, r);
+        sum += dst[r % (ROW_PIXELS * 2)];
+    }
+    report("rgb888_to_rgb565", now_s() - t0, sum);
+
+    sum = 0;
+    t0 = now_s();
+    for (uint32_t r = 0; r < ROWS; r++) {
+        st7735_argb8888_to_rgb565_row(dst, argb, ROW_PIXELS, r, r, 0x18E3);
+        sum += dst[r % (ROW_PIXELS * 2)];
+    }
+    report("argb8888_to_rgb565", now_s() - t0, sum);
+    return 0;
+}
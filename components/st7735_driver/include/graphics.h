@@ -3,17 +3,47 @@
 #include <stdint.h>
 #include "st7735.h"
 
+// Vértice de polígono (coordenadas em pixels, podem sair do ecrã)
+typedef struct {
+    int16_t x;
+    int16_t y;
+} point_t;
+
+// Número máximo de vértices aceite por draw_filled_polygon() e draw_filled_polygon_aa()
+#define POLY_MAX_POINTS 32
+
 // Protótipos de funções gráficas
-void draw_pixel(uint16_t x, uint16_t y, uint16_t color);
-void draw_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color);
-void draw_vline(uint16_t x, uint16_t y, uint16_t h, uint16_t color);
-void draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
-void draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
-void draw_filled_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
-void draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color);
-void draw_filled_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color);
+void draw_pixel(int16_t x, int16_t y, uint16_t color);
+void draw_hline(int16_t x, int16_t y, uint16_t w, uint16_t color);
+void draw_vline(int16_t x, int16_t y, uint16_t h, uint16_t color);
+void draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+void draw_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void draw_filled_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+void draw_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color);
+void draw_filled_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color);
 
 // Funções de texto
-void draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
-void draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
-void draw_image_rgb565(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *image_data);
\ No newline at end of file
+void draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
+void draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
+void draw_image_rgb565(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint16_t *image_data);
+
+// Preenchimentos procedurais (linhas geradas no buffer DMA, uma única janela)
+void fill_linear_gradient(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t c0, uint16_t c1, bool vertical);
+// O raio pode ir até 65535 px: acima de 4096 px a distância é calculada com meio pixel de resolução
+void fill_radial_gradient(int16_t x, int16_t y, uint16_t w, uint16_t h, int16_t cx, int16_t cy, uint16_t r, uint16_t inner, uint16_t outer);
+void fill_checker(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t cell, uint16_t c0, uint16_t c1);
+void fill_stripes(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t width, uint16_t c0, uint16_t c1, bool vertical);
+void draw_filled_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t r, uint16_t color, uint16_t bg);
+
+// Rasterização por scanline (spans iguais em linhas seguidas são enviados numa só janela)
+// Triângulos e polígonos incluem as arestas e os vértices (como draw_line), pelo que
+// formas finas ou degeneradas continuam visíveis
+void draw_filled_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+// Polígonos com mais de POLY_MAX_POINTS vértices não são desenhados
+void draw_filled_polygon(const point_t *pts, uint8_t n, uint16_t color);
+void draw_thick_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color);
+
+// Variantes com anti-aliasing das arestas sobre um fundo sólido conhecido
+void draw_filled_triangle_aa(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color, uint16_t bg);
+void draw_filled_polygon_aa(const point_t *pts, uint8_t n, uint16_t color, uint16_t bg);
+void draw_thick_line_aa(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color, uint16_t bg);
@@ -69,6 +69,19 @@ typedef struct {
     spi_host_device_t host_id; /**< Host SPI (SPI2_HOST ou SPI3_HOST) */
 } st7735_config_t;
 
+/**
+ * @brief Gerador de pixels para st7735_stream_rect()
+ *
+ * Escreve `count` pixels RGB565 big-endian em `buf`, começando no pixel
+ * (x, y) do ecrã. Chamado uma vez por linha visível da janela, já
+ * recortada: (x, y) está sempre dentro da região de recorte.
+ *
+ * O callback corre enquanto o bloco anterior ainda está em transmissão DMA:
+ * deve apenas preencher `buf` e nunca chamar outras funções st7735_* nem
+ * aceder ao display (o SPI rejeita transações enquanto há uma pendente).
+ */
+typedef void (*st7735_row_cb_t)(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx);
+
 /* ==================== Funções Públicas ==================== */
 
 /**
@@ -80,11 +93,11 @@ esp_err_t st7735_init(const st7735_config_t *cfg);
 
 /**
  * @brief Desenha um pixel
- * @param x Coordenada X (0 a width-1)
- * @param y Coordenada Y (0 a height-1)
+ * @param x Coordenada X (fora da região de recorte é ignorado)
+ * @param y Coordenada Y (fora da região de recorte é ignorado)
  * @param color Cor em formato RGB565
  */
-void st7735_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
+void st7735_draw_pixel(int16_t x, int16_t y, uint16_t color);
 
 /**
  * @brief Preenche um retângulo com uma cor
@@ -94,7 +107,7 @@ void st7735_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
  * @param h Altura do retângulo
  * @param color Cor em formato RGB565
  */
-void st7735_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void st7735_fill_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
 
 /**
  * @brief Preenche todo o ecrã com uma cor
@@ -118,6 +131,13 @@ void st7735_set_rotation(uint8_t rotation);
  */
 void st7735_invert_display(bool invert);
 
+/**
+ * @brief Fonte 5x7 usada pelo texto (caracteres ASCII 32-127)
+ *
+ * 5 bytes por caractere, um por coluna; o bit 0 é a linha de cima.
+ */
+extern const uint8_t st7735_font5x7[96 * 5];
+
 /**
  * @brief Desenha um caractere
  * @param x Coordenada X
@@ -127,7 +147,7 @@ void st7735_invert_display(bool invert);
  * @param bg Cor de fundo
  * @param size Escala (1 = 5x7, 2 = 10x14, etc.)
  */
-void st7735_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
+void st7735_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
 
 /**
  * @brief Desenha uma string de texto
@@ -138,7 +158,7 @@ void st7735_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t b
  * @param bg Cor de fundo
  * @param size Escala do texto
  */
-void st7735_draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
+void st7735_draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
 
 /**
  * @brief Obtém a largura atual do display
@@ -160,7 +180,128 @@ uint16_t st7735_get_height(void);
  * @param h Altura da imagem
  * @param data Ponteiro para array de pixels RGB565 (big-endian)
  */
-void st7735_draw_image(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+void st7735_draw_image(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+
+/**
+ * @brief Define a região de recorte aplicada a todas as primitivas
+ *
+ * Primitivas totalmente fora da região são rejeitadas antes de qualquer
+ * tráfego SPI; as parcialmente visíveis são recortadas a uma só janela.
+ * A região é reposta para o ecrã inteiro em st7735_set_rotation().
+ * @param x Coordenada X do canto superior esquerdo (pode ser negativa)
+ * @param y Coordenada Y do canto superior esquerdo (pode ser negativa)
+ * @param w Largura da região
+ * @param h Altura da região
+ */
+void st7735_set_clip_rect(int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+/**
+ * @brief Repõe a região de recorte para o ecrã inteiro
+ */
+void st7735_reset_clip_rect(void);
+
+/**
+ * @brief Obtém a região de recorte atual (limites inclusivos)
+ * @param x0 Coluna mais à esquerda
+ * @param y0 Linha do topo
+ * @param x1 Coluna mais à direita (menor que x0 se a região estiver vazia)
+ * @param y1 Linha do fundo
+ */
+void st7735_get_clip_rect(int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1);
+
+/**
+ * @brief Obtém a rotação atual do display
+ * @return Valor de 0 a 3 (ver st7735_set_rotation())
+ */
+uint8_t st7735_get_rotation(void);
+
+/**
+ * @brief Define uma faixa de linhas para scroll vertical por hardware
+ *
+ * Só disponível nas rotações portrait (0 e 2), onde as linhas do ecrã
+ * coincidem com as linhas da memória do controlador. A faixa ocupa a
+ * largura inteira do ecrã. Na rotação 2 o conteúdo desloca-se no sentido
+ * inverso (a linha mais recente aparece no topo da faixa).
+ * @param y Primeira linha da faixa
+ * @param h Altura da faixa (0 desativa o scroll)
+ * @return ESP_OK, ESP_ERR_NOT_SUPPORTED em landscape, ESP_ERR_INVALID_ARG fora do ecrã
+ */
+esp_err_t st7735_set_scroll_area(int16_t y, uint16_t h);
+
+/**
+ * @brief Avança o scroll vertical uma linha
+ *
+ * A linha mais antiga da faixa passa para a extremidade "nova"; o valor
+ * devolvido é a coordenada Y (sem scroll) onde se deve desenhar o novo
+ * conteúdo dessa linha.
+ * @return Linha a redesenhar, ou -1 se não houver área de scroll ativa
+ */
+int16_t st7735_scroll_advance(void);
+
+/**
+ * @brief Desenha uma imagem RGB888 com conversão e dithering para RGB565
+ * @param x Coordenada X do canto superior esquerdo
+ * @param y Coordenada Y do canto superior esquerdo
+ * @param w Largura da imagem
+ * @param h Altura da imagem
+ * @param data Ponteiro para pixels RGB888 (3 bytes por pixel: R, G, B)
+ */
+void st7735_draw_image_rgb888(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data);
+
+/**
+ * @brief Desenha uma imagem ARGB8888 misturada sobre uma cor de fundo
+ * @param x Coordenada X do canto superior esquerdo
+ * @param y Coordenada Y do canto superior esquerdo
+ * @param w Largura da imagem
+ * @param h Altura da imagem
+ * @param data Ponteiro para pixels 0xAARRGGBB
+ * @param bg Cor de fundo RGB565 sob os pixels transparentes
+ */
+void st7735_draw_image_argb8888(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint32_t *data, uint16_t bg);
+
+/**
+ * @brief Desenha um bitmap monocromático (1 bit por pixel)
+ *
+ * Cada linha ocupa (w + 7) / 8 bytes; o pixel mais à esquerda é o bit mais
+ * significativo. Os bits são expandidos diretamente no buffer DMA e o
+ * bitmap é enviado numa única janela.
+ * @param x Coordenada X do canto superior esquerdo
+ * @param y Coordenada Y do canto superior esquerdo
+ * @param w Largura do bitmap
+ * @param h Altura do bitmap
+ * @param data Bits do bitmap
+ * @param fg Cor dos bits a 1
+ * @param bg Cor dos bits a 0
+ */
+void st7735_draw_bitmap_1bpp(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data, uint16_t fg, uint16_t bg);
+
+/**
+ * @brief Desenha um bitmap de 2 bits por pixel com paleta de 4 cores
+ *
+ * Cada linha ocupa (w + 3) / 4 bytes; o pixel mais à esquerda ocupa os
+ * dois bits mais significativos.
+ * @param x Coordenada X do canto superior esquerdo
+ * @param y Coordenada Y do canto superior esquerdo
+ * @param w Largura do bitmap
+ * @param h Altura do bitmap
+ * @param data Pixels do bitmap (índices 0-3)
+ * @param palette 4 cores RGB565
+ */
+void st7735_draw_bitmap_2bpp(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data, const uint16_t *palette);
+
+/**
+ * @brief Envia um retângulo cujas linhas são geradas por um callback
+ *
+ * Abre uma única janela de endereços e gera as linhas diretamente nos
+ * buffers DMA do driver, sobrepondo a geração com a transmissão.
+ * @param x Coordenada X do canto superior esquerdo
+ * @param y Coordenada Y do canto superior esquerdo
+ * @param w Largura do retângulo
+ * @param h Altura do retângulo
+ * @param cb Gerador de pixels de cada linha
+ * @param ctx Contexto passado ao callback
+ */
+void st7735_stream_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, st7735_row_cb_t cb, void *ctx);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,81 @@
+/**
+ * @file st7735_color.h
+ * @brief Conversão de cores RGB888/ARGB8888 para RGB565 com dithering ordenado
+ *
+ * Kernels de linha sem dependências do ESP-IDF: escrevem pixels RGB565
+ * big-endian (formato enviado ao display) diretamente num buffer de destino.
+ * O dithering usa uma matriz de Bayer 4x4 ancorada às coordenadas do ecrã,
+ * para que blits adjacentes encaixem sem costuras.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Expande uma cor RGB565 para RGB888 (replicando os bits altos)
+ * @param c Cor RGB565
+ * @param rgb Destino (3 bytes: R, G, B)
+ */
+static inline void st7735_rgb565_to_rgb888(uint16_t c, uint8_t *rgb) {
+    rgb[0] = ((c >> 11) << 3) | (c >> 13);
+    rgb[1] = (((c >> 5) & 0x3F) << 2) | ((c >> 9) & 0x03);
+    rgb[2] = ((c & 0x1F) << 3) | ((c >> 2) & 0x07);
+}
+
+/**
+ * @brief Converte uma linha RGB888 para RGB565 com dithering
+ * @param dst Destino (2 bytes por pixel, big-endian)
+ * @param src Origem (3 bytes por pixel: R, G, B)
+ * @param count Número de pixels
+ * @param x Coordenada X do primeiro pixel no ecrã (fase do dithering)
+ * @param y Coordenada Y da linha no ecrã (fase do dithering)
+ */
+void st7735_rgb888_to_rgb565_row(uint8_t *dst, const uint8_t *src, uint16_t count, uint16_t x, uint16_t y);
+
+/**
+ * @brief Converte uma linha ARGB8888 para RGB565, misturando sobre um fundo sólido
+ * @param dst Destino (2 bytes por pixel, big-endian)
+ * @param src Origem (0xAARRGGBB por pixel)
+ * @param count Número de pixels
+ * @param x Coordenada X do primeiro pixel no ecrã (fase do dithering)
+ * @param y Coordenada Y da linha no ecrã (fase do dithering)
+ * @param bg Cor de fundo RGB565 usada na mistura alfa
+ */
+void st7735_argb8888_to_rgb565_row(uint8_t *dst, const uint32_t *src, uint16_t count,
+                                   uint16_t x, uint16_t y, uint16_t bg);
+
+/**
+ * @brief Expande uma linha de bitmap 1-bpp para RGB565
+ *
+ * Os bits são lidos do mais significativo para o menos significativo.
+ * Cada bit origina `scale` pixels consecutivos (texto ampliado).
+ * @param dst Destino (2 bytes por pixel, big-endian)
+ * @param bits Linha de bits da origem
+ * @param first Primeiro pixel de destino a gerar (em pixels já ampliados)
+ * @param count Número de pixels a gerar
+ * @param scale Fator de ampliação horizontal (>= 1)
+ * @param fg Cor dos bits a 1
+ * @param bg Cor dos bits a 0
+ */
+void st7735_expand_1bpp_row(uint8_t *dst, const uint8_t *bits, uint16_t first, uint16_t count,
+                            uint8_t scale, uint16_t fg, uint16_t bg);
+
+/**
+ * @brief Expande uma linha de bitmap 2-bpp (paleta de 4 cores) para RGB565
+ * @param dst Destino (2 bytes por pixel, big-endian)
+ * @param bits Linha da origem (4 pixels por byte, pixel mais à esquerda nos bits altos)
+ * @param first Primeiro pixel da linha a gerar
+ * @param count Número de pixels a gerar
+ * @param palette 4 cores RGB565 indexadas pelos valores 0-3
+ */
+void st7735_expand_2bpp_row(uint8_t *dst, const uint8_t *bits, uint16_t first, uint16_t count,
+                            const uint16_t *palette);
+
+#ifdef __cplusplus
+}
+#endif
@@ -23,9 +23,11 @@
 #define ST7735_RAMRD     0x2E  // Memory Read
 
 #define ST7735_PTLAR     0x30  // Partial Area
+#define ST7735_VSCRDEF   0x33  // Vertical Scrolling Definition
 #define ST7735_TEOFF     0x34  // Tearing Effect Line Off
 #define ST7735_TEON      0x35  // Tearing Effect Line On
 #define ST7735_MADCTL    0x36  // Memory Data Access Control
+#define ST7735_VSCSAD    0x37  // Vertical Scroll Start Address
 #define ST7735_IDMOFF    0x38  // Idle Mode Off
 #define ST7735_IDMON     0x39  // Idle Mode On
 #define ST7735_COLMOD    0x3A  // Interface Pixel Format
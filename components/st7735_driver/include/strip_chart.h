@@ -0,0 +1,110 @@
+/**
+ * @file strip_chart.h
+ * @brief Gráfico de tira (strip chart) incremental para leituras de sensores
+ *
+ * Guarda as amostras num buffer circular e, a cada nova amostra, redesenha
+ * apenas a coluna (ou linha) correspondente: o custo por amostra é constante
+ * e não depende do número de amostras visíveis.
+ *
+ * @example
+ * ```c
+ * strip_chart_t chart;
+ * strip_chart_config_t cfg = {
+ *     .x = 0, .y = 20, .w = 160, .h = 60,
+ *     .min = 0, .max = 1000,
+ *     .color = ST7735_GREEN, .bg = ST7735_BLACK,
+ *     .mode = STRIP_CHART_SWEEP,
+ * };
+ * strip_chart_init(&chart, &cfg);
+ * while (1) strip_chart_push(&chart, ler_sensor());
+ * ```
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "st7735.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Forma de avanço do gráfico
+ */
+typedef enum {
+    /** Eixo do tempo horizontal; o cursor de escrita percorre a área e volta ao início */
+    STRIP_CHART_SWEEP,
+    /** Eixo do tempo vertical com scroll por hardware (só rotações 0 e 2) */
+    STRIP_CHART_SCROLL,
+} strip_chart_mode_t;
+
+/**
+ * @brief Configuração do gráfico
+ */
+typedef struct {
+    int16_t x;                 /**< Coordenada X do canto superior esquerdo */
+    int16_t y;                 /**< Coordenada Y do canto superior esquerdo */
+    uint16_t w;                /**< Largura da área */
+    uint16_t h;                /**< Altura da área */
+    int16_t min;               /**< Valor mapeado para o fundo (ou esquerda) */
+    int16_t max;               /**< Valor mapeado para o topo (ou direita) */
+    uint16_t color;            /**< Cor do traço */
+    uint16_t bg;               /**< Cor de fundo */
+    strip_chart_mode_t mode;   /**< Modo de avanço */
+} strip_chart_config_t;
+
+/**
+ * @brief Estado do gráfico (campos internos, não alterar diretamente)
+ */
+typedef struct {
+    strip_chart_config_t cfg;
+    int16_t *samples;          /**< Buffer circular de amostras */
+    uint16_t capacity;         /**< Número de amostras guardadas (colunas ou linhas) */
+    uint16_t head;             /**< Próxima posição a escrever */
+    uint16_t count;            /**< Amostras válidas no buffer */
+} strip_chart_t;
+
+/**
+ * @brief Inicializa o gráfico e limpa a sua área
+ *
+ * No modo STRIP_CHART_SCROLL a área de scroll ocupa a largura inteira do
+ * ecrã: qualquer outro conteúdo nessas linhas desloca-se com o gráfico.
+ *
+ * O buffer de amostras é alocado de novo a cada chamada: para reconfigurar
+ * um gráfico já inicializado, chamar strip_chart_deinit() antes.
+ * @param chart Estado a inicializar
+ * @param cfg Configuração (copiada)
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_NO_MEM ou ESP_ERR_NOT_SUPPORTED
+ *         (modo scroll em landscape)
+ */
+esp_err_t strip_chart_init(strip_chart_t *chart, const strip_chart_config_t *cfg);
+
+/**
+ * @brief Acrescenta uma amostra e desenha apenas a coluna/linha nova
+ *
+ * No modo STRIP_CHART_SCROLL, com o buffer cheio, redesenha também a linha
+ * da amostra mais antiga (uma janela de 1 linha a mais): o segmento que a
+ * ligava à amostra descartada desaparece, tal como em strip_chart_redraw().
+ * @param chart Gráfico
+ * @param value Valor (saturado a [min, max])
+ */
+void strip_chart_push(strip_chart_t *chart, int16_t value);
+
+/**
+ * @brief Redesenha a área inteira a partir do buffer (numa única janela)
+ * @param chart Gráfico
+ * @return ESP_OK, ESP_ERR_INVALID_STATE (gráfico não inicializado) ou o erro
+ *         de st7735_set_scroll_area() no modo scroll
+ */
+esp_err_t strip_chart_redraw(strip_chart_t *chart);
+
+/**
+ * @brief Liberta o buffer de amostras (e a área de scroll, se usada)
+ * @param chart Gráfico
+ */
+void strip_chart_deinit(strip_chart_t *chart);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,73 +1,80 @@
 #include "graphics.h"
 #include "st7735.h"
+#include "st7735_color.h"
 #include <stdlib.h>
 #include <string.h>
 
-// Fonte 5x7 básica (caracteres ASCII 32-127)
-extern const uint8_t font5x7[];
-
-void draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
+void draw_pixel(int16_t x, int16_t y, uint16_t color) {
     st7735_draw_pixel(x, y, color);
 }
 
-void draw_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color) {
+void draw_hline(int16_t x, int16_t y, uint16_t w, uint16_t color) {
     st7735_fill_rect(x, y, w, 1, color);
 }
 
-void draw_vline(uint16_t x, uint16_t y, uint16_t h, uint16_t color) {
+void draw_vline(int16_t x, int16_t y, uint16_t h, uint16_t color) {
     st7735_fill_rect(x, y, 1, h, color);
 }
 
-void draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
-    int16_t steep = abs((int16_t)y1 - (int16_t)y0) > abs((int16_t)x1 - (int16_t)x0);
-    int16_t dx, dy, err, ystep;
+// Rejeita caixas (limites inclusivos) totalmente fora da região de recorte
+static bool outside_clip(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    int16_t cx0, cy0, cx1, cy1;
+    st7735_get_clip_rect(&cx0, &cy0, &cx1, &cy1);
+    return x1 < cx0 || x0 > cx1 || y1 < cy0 || y0 > cy1;
+}
+
+void draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (outside_clip(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, x0 > x1 ? x0 : x1, y0 > y1 ? y0 : y1)) return;
+    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    int32_t dx, dy, err, ystep;
 
     if (steep) {
         // Swap x0, y0
-        uint16_t tmp = x0; x0 = y0; y0 = tmp;
+        int16_t tmp = x0; x0 = y0; y0 = tmp;
         // Swap x1, y1
         tmp = x1; x1 = y1; y1 = tmp;
     }
 
     if (x0 > x1) {
         // Swap x0, x1
-        uint16_t tmp = x0; x0 = x1; x1 = tmp;
+        int16_t tmp = x0; x0 = x1; x1 = tmp;
         // Swap y0, y1
         tmp = y0; y0 = y1; y1 = tmp;
     }
 
     dx = x1 - x0;
-    dy = abs((int16_t)y1 - (int16_t)y0);
+    dy = abs(y1 - y0);
 
     err = dx / 2;
     ystep = (y0 < y1) ? 1 : -1;
 
-    for (; x0 <= x1; x0++) {
+    for (int32_t x = x0, y = y0; x <= x1; x++) {
         if (steep) {
-            draw_pixel(y0, x0, color);
+            draw_pixel(y, x, color);
         } else {
-            draw_pixel(x0, y0, color);
+            draw_pixel(x, y, color);
         }
         err -= dy;
         if (err < 0) {
-            y0 += ystep;
+            y += ystep;
             err += dx;
         }
     }
 }
 
-void draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+void draw_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
     draw_hline(x, y, w, color);          // Top
     draw_hline(x, y + h - 1, w, color);  // Bottom
     draw_vline(x, y, h, color);          // Left
     draw_vline(x + w - 1, y, h, color);  // Right
 }
 
-void draw_filled_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+void draw_filled_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
     st7735_fill_rect(x, y, w, h, color);
 }
 
-void draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
+void draw_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color) {
+    if (outside_clip(x0 - r, y0 - r, x0 + r, y0 + r)) return;
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
@@ -100,7 +107,8 @@ void draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
     }
 }
 
-void draw_filled_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
+void draw_filled_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color) {
+    if (outside_clip(x0 - r, y0 - r, x0 + r, y0 + r)) return;
     draw_vline(x0, y0 - r, 2 * r + 1, color);
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
@@ -125,42 +133,35 @@ void draw_filled_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
     }
 }
 
-void draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (c < 32 || c > 127) c = '?'; // Substitui caracteres fora do range
+void draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (size == 0) return;
+    if (bg != color) {
+        // Fundo opaco: glifo expandido numa única janela + coluna de espaço
+        st7735_draw_char(x, y, c, color, bg, size);
+        st7735_fill_rect(x + 5 * size, y, size, 7 * size, bg);
+        return;
+    }
+
+    uint8_t code = (uint8_t)c;
+    if (code < 32 || code > 127) code = '?'; // Substitui caracteres fora do range
     
-    uint8_t index = c - 32;
+    uint8_t index = code - 32;
     
+    // Fundo transparente: só os pixels acesos, agrupados em segmentos verticais
     for (uint8_t i = 0; i < 5; i++) {
-        uint8_t line = font5x7[index * 5 + i];
-        for (uint8_t j = 0; j < 7; j++) {
-            if (line & (1 << j)) {
-                if (size == 1) {
-                    draw_pixel(x + i, y + j, color);
-                } else {
-                    st7735_fill_rect(x + i * size, y + j * size, size, size, color);
-                }
-            } else if (bg != color) {
-                if (size == 1) {
-                    draw_pixel(x + i, y + j, bg);
-                } else {
-                    st7735_fill_rect(x + i * size, y + j * size, size, size, bg);
-                }
-            }
-        }
-    }
-    
-    // Espaço entre caracteres
-    if (bg != color) {
-        if (size == 1) {
-            draw_vline(x + 5, y, 7, bg);
-        } else {
-            st7735_fill_rect(x + 5 * size, y, size, 7 * size, bg);
+        uint8_t line = st7735_font5x7[index * 5 + i];
+        for (uint8_t j = 0; j < 7; ) {
+            if (!(line & (1 << j))) { j++; continue; }
+            uint8_t run = j;
+            while (run < 7 && (line & (1 << run))) run++;
+            st7735_fill_rect(x + i * size, y + j * size, size, (run - j) * size, color);
+            j = run;
         }
     }
 }
 
-void draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
-    uint16_t cursor_x = x;
+void draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
+    int16_t cursor_x = x;
     
     while (*str) {
         if (*str == '\n') {
@@ -174,7 +175,7 @@ void draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16
     }
 }
 
-void draw_image_rgb565(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *image_data) {
+void draw_image_rgb565(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint16_t *image_data) {
     if (image_data == NULL) {
         return;
     }
@@ -182,3 +183,530 @@ void draw_image_rgb565(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
     // Usa a função otimizada do driver ST7735
     st7735_draw_image(x, y, width, height, image_data);
 }
+
+// ==================== Preenchimentos procedurais ====================
+
+typedef struct {
+    int16_t x0, y0;
+    uint16_t w, h;
+    uint16_t c0, c1;
+    uint8_t rgb0[3], rgb1[3];
+    int16_t cx, cy;            // Centro do gradiente radial
+    int16_t col0;              // Primeira coluna visível do gradiente horizontal
+    uint16_t r, size;
+    bool vertical;
+} fill_ctx_t;
+
+// Linha RGB888 intermédia dos gradientes (antes do dithering). Estática para
+// não pesar na stack de quem chama; o driver já é de uma só tarefa.
+static uint8_t gradient_row[ST7735_WIDTH * 3];
+
+static uint32_t isqrt32(uint32_t v) {
+    uint32_t res = 0, bit = 1UL << 30;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= res + bit) { v -= res + bit; res = (res >> 1) + bit; }
+        else res >>= 1;
+        bit >>= 2;
+    }
+    return res;
+}
+
+// Interpola entre rgb0 e rgb1 com t em 0..255
+static inline void lerp_rgb(uint8_t *dst, const fill_ctx_t *f, uint16_t t) {
+    for (int i = 0; i < 3; i++) dst[i] = f->rgb0[i] + (((int16_t)f->rgb1[i] - f->rgb0[i]) * t) / 255;
+}
+
+static void linear_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    fill_ctx_t *f = ctx;
+    if (f->vertical) {
+        // Linha de cor constante; só o dithering varia ao longo da linha
+        uint16_t t = (f->h > 1) ? (uint32_t)(y - f->y0) * 255 / (f->h - 1) : 0;
+        lerp_rgb(gradient_row, f, t);
+        for (uint16_t i = 1; i < count; i++) memcpy(&gradient_row[i * 3], gradient_row, 3);
+        st7735_rgb888_to_rgb565_row(buf, gradient_row, count, x, y);
+    } else {
+        // Só as colunas visíveis foram pré-calculadas, a partir de col0
+        st7735_rgb888_to_rgb565_row(buf, &gradient_row[(x - f->col0) * 3], count, x, y);
+    }
+}
+
+void fill_linear_gradient(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t c0, uint16_t c1, bool vertical) {
+    fill_ctx_t f = { .x0 = x, .y0 = y, .w = w, .h = h, .vertical = vertical };
+    st7735_rgb565_to_rgb888(c0, f.rgb0);
+    st7735_rgb565_to_rgb888(c1, f.rgb1);
+    if (!vertical) {
+        // Gradiente horizontal: todas as linhas são iguais, calcula-se uma vez
+        // (apenas as colunas dentro da região de recorte)
+        int16_t cx0, cy0, cx1, cy1;
+        st7735_get_clip_rect(&cx0, &cy0, &cx1, &cy1);
+        int32_t first = (x > cx0) ? x : cx0;
+        int32_t last = (x + w - 1 < cx1) ? x + w - 1 : cx1;
+        if (first > last || w == 0) return;
+        f.col0 = first;
+        for (int32_t col = first; col <= last; col++) {
+            uint32_t i = col - x;
+            lerp_rgb(&gradient_row[(col - first) * 3], &f, (w > 1) ? i * 255 / (w - 1) : 0);
+        }
+    }
+    st7735_stream_rect(x, y, w, h, linear_row, &f);
+}
+
+static void radial_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    fill_ctx_t *f = ctx;
+    int32_t dy = (int32_t)y - f->cy;
+    uint32_t r16 = (uint32_t)f->r * 16;
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t dx = (int32_t)(x + i) - f->cx;
+        uint16_t t = 255;
+        if (abs(dx) <= f->r && abs(dy) <= f->r) {
+            // Distância em 1/16 de pixel para evitar degraus em raios pequenos.
+            // Acima de 4096 px o quadrado já não cabe deslocado em 32 bits e
+            // basta meio pixel de resolução
+            int64_t d2 = (int64_t)dx * dx + (int64_t)dy * dy;
+            uint32_t d16 = (d2 < (1L << 24)) ? isqrt32((uint32_t)d2 << 8) : isqrt32((uint32_t)(d2 >> 2)) << 5;
+            if (d16 < r16) t = d16 * 255 / r16;
+        }
+        lerp_rgb(&gradient_row[i * 3], f, t);
+    }
+    st7735_rgb888_to_rgb565_row(buf, gradient_row, count, x, y);
+}
+
+void fill_radial_gradient(int16_t x, int16_t y, uint16_t w, uint16_t h, int16_t cx, int16_t cy, uint16_t r, uint16_t inner, uint16_t outer) {
+    if (r == 0) { st7735_fill_rect(x, y, w, h, outer); return; }
+    if (outside_clip(x, y, x + w - 1, y + h - 1)) return;
+    fill_ctx_t f = { .x0 = x, .y0 = y, .w = w, .h = h, .cx = cx, .cy = cy, .r = r };
+    st7735_rgb565_to_rgb888(inner, f.rgb0);
+    st7735_rgb565_to_rgb888(outer, f.rgb1);
+    st7735_stream_rect(x, y, w, h, radial_row, &f);
+}
+
+static inline void put_px(uint8_t *buf, uint16_t i, uint16_t color) {
+    buf[i*2] = color >> 8;
+    buf[i*2+1] = color & 0xFF;
+}
+
+static void checker_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const fill_ctx_t *f = ctx;
+    uint16_t phase = ((y - f->y0) / f->size) & 1;
+    for (uint16_t i = 0; i < count; i++) {
+        put_px(buf, i, ((((x + i - f->x0) / f->size) & 1) ^ phase) ? f->c1 : f->c0);
+    }
+}
+
+void fill_checker(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t cell, uint16_t c0, uint16_t c1) {
+    if (cell == 0) return;
+    fill_ctx_t f = { .x0 = x, .y0 = y, .size = cell, .c0 = c0, .c1 = c1 };
+    st7735_stream_rect(x, y, w, h, checker_row, &f);
+}
+
+static void stripes_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const fill_ctx_t *f = ctx;
+    if (f->vertical) {
+        for (uint16_t i = 0; i < count; i++) {
+            put_px(buf, i, (((x + i - f->x0) / f->size) & 1) ? f->c1 : f->c0);
+        }
+    } else {
+        uint16_t color = (((y - f->y0) / f->size) & 1) ? f->c1 : f->c0;
+        for (uint16_t i = 0; i < count; i++) put_px(buf, i, color);
+    }
+}
+
+void fill_stripes(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t width, uint16_t c0, uint16_t c1, bool vertical) {
+    if (width == 0) return;
+    fill_ctx_t f = { .x0 = x, .y0 = y, .size = width, .c0 = c0, .c1 = c1, .vertical = vertical };
+    st7735_stream_rect(x, y, w, h, stripes_row, &f);
+}
+
+static void round_rect_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const fill_ctx_t *f = ctx;
+    uint16_t row = y - f->y0;
+    uint16_t inset = 0;
+    if (row < f->r || row >= f->h - f->r) {
+        // Distância (em meios pixels) do centro da linha ao centro do arco
+        uint16_t j = (row < f->r) ? row : f->h - 1 - row;
+        uint32_t dy2 = 2 * (f->r - j) - 1;
+        uint32_t half = isqrt32(4UL * f->r * f->r - dy2 * dy2);
+        inset = f->r - (half + 1) / 2;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t col = x + i - f->x0;
+        put_px(buf, i, (col < inset || col >= f->w - inset) ? f->c1 : f->c0);
+    }
+}
+
+void draw_filled_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t r, uint16_t color, uint16_t bg) {
+    if (r > w / 2) r = w / 2;
+    if (r > h / 2) r = h / 2;
+    fill_ctx_t f = { .x0 = x, .y0 = y, .w = w, .h = h, .r = r, .c0 = color, .c1 = bg };
+    st7735_stream_rect(x, y, w, h, round_rect_row, &f);
+}
+
+// ==================== Rasterização de polígonos ====================
+//
+// Os vértices são convertidos para 1/16 de pixel, com o centro do pixel (x, y)
+// em (x*16+8, y*16+8). Cada linha é amostrada no centro (regra par-ímpar para
+// polígonos côncavos). Nos polígonos de vértices inteiros a região é fechada,
+// como no fillTriangle da Adafruit-GFX: cobrem-se os pixels com centro em
+// [xl, xr], a linha do último vértice e os pixels tocados pelas arestas, para
+// que formas finas ou degeneradas desenhem o mesmo que draw_line. As linhas
+// grossas usam a região aberta [xl, xr), para não ganharem um pixel de largura.
+
+static uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t a) {
+    uint8_t f[3], k[3];
+    st7735_rgb565_to_rgb888(fg, f);
+    st7735_rgb565_to_rgb888(bg, k);
+    for (int i = 0; i < 3; i++) k[i] = (f[i] * a + k[i] * (255 - a) + 127) / 255;
+    return ST7735_RGB565(k[0], k[1], k[2]);
+}
+
+// Anti-aliasing: cada linha de pixels é amostrada em várias sub-linhas e, em
+// cada uma, mede-se a fração horizontal coberta; a soma aproxima a área real
+// coberta, incluindo em arestas quase horizontais.
+#define AA_SUBSAMPLES 8
+#define AA_FULL       (AA_SUBSAMPLES * 16)   // Cobertura de um pixel inteiro
+
+typedef struct {
+    const uint8_t *cov;     // Cobertura por coluna, a partir de cov_x0
+    int16_t cov_x0;
+    uint16_t color, bg;
+} aa_row_t;
+
+static void aa_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const aa_row_t *r = ctx;
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t c = r->cov[x + i - r->cov_x0];
+        uint16_t px = (c >= AA_FULL) ? r->color : blend565(r->color, r->bg, c * 255 / AA_FULL);
+        buf[i*2] = px >> 8;
+        buf[i*2+1] = px & 0xFF;
+    }
+}
+
+#define SPAN_MAX_RUNS 8
+#define SPAN_COV_MAX  4      // Largura máxima de um troço de aresta AA agrupável
+
+typedef struct {
+    int16_t x0, x1, y0, h;
+    bool hit;
+    uint8_t cov[SPAN_COV_MAX];  // Cobertura por coluna (só nos lotes de arestas AA)
+} span_run_t;
+
+// Spans com as mesmas colunas em linhas consecutivas acumulam-se num retângulo.
+// Num lote de arestas AA cada span tem também de repetir a cobertura.
+typedef struct {
+    span_run_t run[SPAN_MAX_RUNS];
+    uint8_t count;
+    bool aa;
+    uint16_t color, bg;
+    int16_t clip_x0, clip_x1;
+} span_batch_t;
+
+static void span_flush_run(span_batch_t *b, uint8_t i) {
+    span_run_t *r = &b->run[i];
+    if (r->h == 0) {
+        // Só marcava uma linha já desenhada: nada a enviar
+    } else if (b->aa) {
+        aa_row_t row = { .cov = r->cov, .cov_x0 = r->x0, .color = b->color, .bg = b->bg };
+        st7735_stream_rect(r->x0, r->y0, r->x1 - r->x0 + 1, r->h, aa_row, &row);
+    } else {
+        st7735_fill_rect(r->x0, r->y0, r->x1 - r->x0 + 1, r->h, b->color);
+    }
+    b->run[i] = b->run[--b->count];
+}
+
+// Retângulo pendente que o span [x0, x1] da linha y continua, ou NULL.
+// cov: cobertura a partir de x0 (só nos lotes AA, com x1 - x0 < SPAN_COV_MAX)
+static span_run_t *span_find(span_batch_t *b, int16_t y, int32_t x0, int32_t x1, const uint8_t *cov) {
+    uint8_t w = b->aa ? x1 - x0 + 1 : 0;
+    for (uint8_t i = 0; i < b->count; i++) {
+        span_run_t *r = &b->run[i];
+        if (!r->hit && r->x0 == x0 && r->x1 == x1 && r->y0 + r->h == y && !memcmp(r->cov, cov, w)) return r;
+    }
+    return NULL;
+}
+
+static void span_add(span_batch_t *b, int16_t y, int32_t x0, int32_t x1, const uint8_t *cov) {
+    if (x0 < b->clip_x0) x0 = b->clip_x0;
+    if (x1 > b->clip_x1) x1 = b->clip_x1;
+    if (x0 > x1) return;
+
+    span_run_t *r = span_find(b, y, x0, x1, cov);
+    if (r) {
+        r->h++;
+        r->hit = true;
+        return;
+    }
+    if (b->count == SPAN_MAX_RUNS) span_flush_run(b, 0);
+    r = &b->run[b->count++];
+    *r = (span_run_t){ .x0 = x0, .x1 = x1, .y0 = y, .h = 1, .hit = true };
+    if (b->aa) memcpy(r->cov, cov, x1 - x0 + 1);
+}
+
+// Regista um span que já foi enviado na linha y, para a linha seguinte o poder continuar
+static void span_mark_drawn(span_batch_t *b, int16_t y, int32_t x0, int32_t x1) {
+    if (b->count == SPAN_MAX_RUNS) span_flush_run(b, 0);
+    b->run[b->count++] = (span_run_t){ .x0 = x0, .x1 = x1, .y0 = y + 1, .h = 0, .hit = true };
+}
+
+// Fecha a linha atual: envia os retângulos que não continuaram nesta linha
+static void span_end_line(span_batch_t *b) {
+    for (int i = b->count - 1; i >= 0; i--) {
+        if (b->run[i].hit) b->run[i].hit = false;
+        else span_flush_run(b, i);
+    }
+}
+
+static void span_finish(span_batch_t *b) {
+    while (b->count) span_flush_run(b, b->count - 1);
+}
+
+// Soma a cobertura (em 1/16 de pixel) do intervalo [xl, xr) de uma sub-linha
+static void aa_accumulate(uint8_t *cov, int16_t cx0, int16_t cx1, int32_t xl, int32_t xr,
+                          int32_t *lo, int32_t *hi) {
+    int32_t p0 = xl >> 4, p1 = (xr - 1) >> 4;
+    if (p0 < cx0) p0 = cx0;
+    if (p1 > cx1) p1 = cx1;
+    for (int32_t p = p0; p <= p1; p++) {
+        int32_t a = (xl > p * 16) ? xl : p * 16;
+        int32_t b = (xr < p * 16 + 16) ? xr : p * 16 + 16;
+        cov[p - cx0] += b - a;
+    }
+    if (p0 <= p1) {
+        if (p0 < *lo) *lo = p0;
+        if (p1 > *hi) *hi = p1;
+    }
+}
+
+// Interseções ordenadas das arestas com a linha horizontal yc (regra par-ímpar)
+static uint8_t poly_crossings(const int32_t *xs, const int32_t *ys, uint8_t n, int32_t yc, int32_t *cross) {
+    uint8_t nc = 0;
+    for (uint8_t i = 0, j = n - 1; i < n; j = i++) {
+        int32_t ya = ys[j], yb = ys[i];
+        if ((ya <= yc && yc < yb) || (yb <= yc && yc < ya)) {
+            int32_t xc = xs[j] + (int64_t)(yc - ya) * (xs[i] - xs[j]) / (yb - ya);
+            // Inserção ordenada: poucas interseções por linha
+            uint8_t k = nc++;
+            while (k > 0 && cross[k - 1] > xc) { cross[k] = cross[k - 1]; k--; }
+            cross[k] = xc;
+        }
+    }
+    return nc;
+}
+
+// Troço contínuo [p0, p1] com cobertura na linha y. Se o interior totalmente
+// coberto continua um retângulo da linha anterior, junta-se a ele como no
+// caminho sem AA, e só as arestas parciais seguem à parte (agrupadas também
+// quando repetem colunas e cobertura, como nas arestas verticais). Caso
+// contrário o troço vai inteiro numa janela de uma linha e o interior fica
+// registado para a linha seguinte o poder continuar.
+static void aa_run(span_batch_t *fill, span_batch_t *edges, aa_row_t *row, int16_t y, int32_t p0, int32_t p1) {
+    const uint8_t *cov = row->cov;
+    int16_t c0 = row->cov_x0;
+    bool joins = false;
+    for (int32_t p = p0; p <= p1 && !joins; ) {
+        if (cov[p - c0] < AA_FULL) { p++; continue; }
+        int32_t end = p;
+        while (end <= p1 && cov[end - c0] >= AA_FULL) end++;
+        joins = span_find(fill, y, p, end - 1, NULL) != NULL;
+        p = end;
+    }
+
+    if (!joins) st7735_stream_rect(p0, y, p1 - p0 + 1, 1, aa_row, row);
+    for (int32_t p = p0; p <= p1; ) {
+        bool full = cov[p - c0] >= AA_FULL;
+        int32_t end = p;
+        while (end <= p1 && (cov[end - c0] >= AA_FULL) == full) end++;
+        if (!joins) {
+            if (full) span_mark_drawn(fill, y, p, end - 1);
+        } else if (full) {
+            span_add(fill, y, p, end - 1, NULL);
+        } else if (end - p <= SPAN_COV_MAX) {
+            span_add(edges, y, p, end - 1, &cov[p - c0]);
+        } else {
+            st7735_stream_rect(p, y, end - p, 1, aa_row, row);
+        }
+        p = end;
+    }
+}
+
+static void fill_poly_aa(const int32_t *xs, const int32_t *ys, uint8_t n, int32_t ymin, int32_t ymax,
+                         uint16_t color, uint16_t bg) {
+    int16_t cx0, cy0, cx1, cy1;
+    st7735_get_clip_rect(&cx0, &cy0, &cx1, &cy1);
+    // Linhas com alguma sub-linha (y*16 + 1, 3, ..., 15) em [ymin, ymax)
+    int32_t y_first = ymin >> 4, y_last = (ymax - 2) >> 4;
+    if (y_first < cy0) y_first = cy0;
+    if (y_last > cy1) y_last = cy1;
+
+    uint8_t cov[ST7735_WIDTH] = { 0 };
+    int32_t cross[POLY_MAX_POINTS];
+    aa_row_t row = { .cov = cov, .cov_x0 = cx0, .color = color, .bg = bg };
+    span_batch_t fill = { .count = 0, .color = color, .clip_x0 = cx0, .clip_x1 = cx1 };
+    span_batch_t edges = { .count = 0, .aa = true, .color = color, .bg = bg, .clip_x0 = cx0, .clip_x1 = cx1 };
+
+    for (int32_t y = y_first; y <= y_last; y++) {
+        int32_t lo = INT32_MAX, hi = INT32_MIN;
+        for (uint8_t s = 0; s < AA_SUBSAMPLES; s++) {
+            uint8_t nc = poly_crossings(xs, ys, n, y * 16 + 2 * s + 1, cross);
+            for (uint8_t k = 0; k + 1 < nc; k += 2) {
+                aa_accumulate(cov, cx0, cx1, cross[k], cross[k + 1], &lo, &hi);
+            }
+        }
+        for (int32_t p = lo; p <= hi; ) {
+            if (!cov[p - cx0]) { p++; continue; }
+            int32_t end = p;
+            while (end <= hi && cov[end - cx0]) end++;
+            aa_run(&fill, &edges, &row, y, p, end - 1);
+            for (int32_t q = p; q < end; q++) cov[q - cx0] = 0;
+            p = end;
+        }
+        span_end_line(&fill);
+        span_end_line(&edges);
+    }
+    span_finish(&fill);
+    span_finish(&edges);
+}
+
+// Pixels da linha y tocados pelas arestas (só nas regiões fechadas)
+static uint8_t poly_edge_runs(const int32_t *xs, const int32_t *ys, uint8_t n, int32_t y,
+                              int32_t *lo, int32_t *hi) {
+    uint8_t nr = 0;
+    int32_t band0 = y * 16, band1 = y * 16 + 15;
+    for (uint8_t i = 0, j = n - 1; i < n; j = i++) {
+        int32_t xa = xs[j], ya = ys[j], xb = xs[i], yb = ys[i];
+        if (ya > yb) { int32_t t = xa; xa = xb; xb = t; t = ya; ya = yb; yb = t; }
+        int32_t t0 = (ya > band0) ? ya : band0, t1 = (yb < band1) ? yb : band1;
+        if (t0 > t1) continue;
+        int32_t x0 = xa, x1 = xb;
+        if (yb != ya) {
+            x0 = xa + (int64_t)(t0 - ya) * (xb - xa) / (yb - ya);
+            x1 = xa + (int64_t)(t1 - ya) * (xb - xa) / (yb - ya);
+        }
+        if (x0 > x1) { int32_t t = x0; x0 = x1; x1 = t; }
+        lo[nr] = x0 >> 4;
+        hi[nr] = (x1 > x0) ? (x1 - 1) >> 4 : lo[nr];
+        nr++;
+    }
+    return nr;
+}
+
+// Ordena os troços pelo início e junta os que se sobrepõem ou tocam
+static uint8_t merge_runs(int32_t *lo, int32_t *hi, uint8_t nr) {
+    for (uint8_t i = 1; i < nr; i++) {
+        int32_t l = lo[i], h = hi[i];
+        uint8_t k = i;
+        while (k > 0 && lo[k - 1] > l) { lo[k] = lo[k - 1]; hi[k] = hi[k - 1]; k--; }
+        lo[k] = l;
+        hi[k] = h;
+    }
+    uint8_t m = 0;
+    for (uint8_t i = 0; i < nr; i++) {
+        if (m > 0 && lo[i] <= hi[m - 1] + 1) {
+            if (hi[i] > hi[m - 1]) hi[m - 1] = hi[i];
+        } else {
+            lo[m] = lo[i];
+            hi[m++] = hi[i];
+        }
+    }
+    return m;
+}
+
+static void fill_poly_fx(const int32_t *xs, const int32_t *ys, uint8_t n, uint16_t color, bool aa, uint16_t bg,
+                         bool closed) {
+    if (n < 3) return;
+    int32_t xmin = xs[0], xmax = xs[0], ymin = ys[0], ymax = ys[0];
+    for (uint8_t i = 1; i < n; i++) {
+        if (xs[i] < xmin) xmin = xs[i];
+        if (xs[i] > xmax) xmax = xs[i];
+        if (ys[i] < ymin) ymin = ys[i];
+        if (ys[i] > ymax) ymax = ys[i];
+    }
+    // Rejeição antecipada: nenhuma interseção é calculada se a caixa não toca a região
+    int16_t cx0, cy0, cx1, cy1;
+    st7735_get_clip_rect(&cx0, &cy0, &cx1, &cy1);
+    if ((xmax >> 4) < cx0 || (xmin >> 4) > cx1) return;
+    if (aa) { fill_poly_aa(xs, ys, n, ymin, ymax, color, bg); return; }
+
+    // Linhas cujo centro (y*16+8) cai em [ymin, ymax] (ou [ymin, ymax)),
+    // limitadas à região
+    int32_t y_first = (ymin + 7) >> 4;
+    int32_t y_last = closed ? (ymax - 8) >> 4 : ((ymax + 7) >> 4) - 1;
+    if (y_first < cy0) y_first = cy0;
+    if (y_last > cy1) y_last = cy1;
+
+    span_batch_t batch = { .count = 0, .color = color, .clip_x0 = cx0, .clip_x1 = cx1 };
+    int32_t cross[POLY_MAX_POINTS];
+    int32_t lo[POLY_MAX_POINTS + POLY_MAX_POINTS / 2], hi[POLY_MAX_POINTS + POLY_MAX_POINTS / 2];
+
+    for (int32_t y = y_first; y <= y_last; y++) {
+        uint8_t nc = poly_crossings(xs, ys, n, y * 16 + 8, cross);
+        uint8_t nr = closed ? poly_edge_runs(xs, ys, n, y, lo, hi) : 0;
+        for (uint8_t k = 0; k + 1 < nc; k += 2) {
+            lo[nr] = (cross[k] + 7) >> 4;
+            hi[nr] = closed ? (cross[k + 1] - 8) >> 4 : ((cross[k + 1] + 7) >> 4) - 1;
+            // Span sem nenhum centro: fica pelo menos o pixel que o contém
+            if (lo[nr] > hi[nr]) lo[nr] = hi[nr] = ((cross[k] + cross[k + 1]) / 2) >> 4;
+            nr++;
+        }
+        nr = merge_runs(lo, hi, nr);
+        for (uint8_t k = 0; k < nr; k++) span_add(&batch, y, lo[k], hi[k], NULL);
+        span_end_line(&batch);
+    }
+    span_finish(&batch);
+}
+
+static void fill_polygon(const point_t *pts, uint8_t n, uint16_t color, bool aa, uint16_t bg) {
+    // Truncar os vértices desenharia outra forma: polígonos grandes demais são recusados
+    if (!pts || n < 3 || n > POLY_MAX_POINTS) return;
+    int32_t xs[POLY_MAX_POINTS], ys[POLY_MAX_POINTS];
+    for (uint8_t i = 0; i < n; i++) {
+        xs[i] = pts[i].x * 16 + 8;
+        ys[i] = pts[i].y * 16 + 8;
+    }
+    fill_poly_fx(xs, ys, n, color, aa, bg, true);
+}
+
+static void thick_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color, bool aa, uint16_t bg) {
+    if (thickness == 0) return;
+    int32_t ht = thickness * 8;    // Meia espessura em 1/16 de pixel
+    int32_t dx = x1 - x0, dy = y1 - y0;
+    // Só a direção interessa: reduz para não transbordar o quadrado
+    while (abs(dx) > 2047 || abs(dy) > 2047) { dx /= 2; dy /= 2; }
+    int32_t len16 = isqrt32((uint32_t)(dx * dx + dy * dy) << 8);
+    int32_t ux, uy;
+    if (len16 == 0) { ux = ht; uy = 0; }
+    else { ux = dx * ht * 16 / len16; uy = dy * ht * 16 / len16; }
+
+    // Retângulo orientado com pontas quadradas (prolongadas meia espessura)
+    int32_t ax = x0 * 16 + 8 - ux, ay = y0 * 16 + 8 - uy;
+    int32_t bx = x1 * 16 + 8 + ux, by = y1 * 16 + 8 + uy;
+    int32_t xs[4] = { ax - uy, bx - uy, bx + uy, ax + uy };
+    int32_t ys[4] = { ay + ux, by + ux, by - ux, ay - ux };
+    fill_poly_fx(xs, ys, 4, color, aa, bg, false);
+}
+
+void draw_filled_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    point_t pts[3] = { { x0, y0 }, { x1, y1 }, { x2, y2 } };
+    fill_polygon(pts, 3, color, false, 0);
+}
+
+void draw_filled_polygon(const point_t *pts, uint8_t n, uint16_t color) {
+    fill_polygon(pts, n, color, false, 0);
+}
+
+void draw_thick_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color) {
+    thick_line(x0, y0, x1, y1, thickness, color, false, 0);
+}
+
+void draw_filled_triangle_aa(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color, uint16_t bg) {
+    point_t pts[3] = { { x0, y0 }, { x1, y1 }, { x2, y2 } };
+    fill_polygon(pts, 3, color, true, bg);
+}
+
+void draw_filled_polygon_aa(const point_t *pts, uint8_t n, uint16_t color, uint16_t bg) {
+    fill_polygon(pts, n, color, true, bg);
+}
+
+void draw_thick_line_aa(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color, uint16_t bg) {
+    thick_line(x0, y0, x1, y1, thickness, color, true, bg);
+}
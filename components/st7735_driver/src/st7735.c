@@ -10,11 +10,14 @@
 #include "esp_heap_caps.h"
 #include "st7735.h"
 #include "st7735_commands.h"
+#include "st7735_color.h"
 
 static const char *TAG = "ST7735";
 
 #define SPI_CLOCK_SPEED_HZ  (8 * 1000 * 1000)
 #define MAX_TRANSFER_SIZE   (160 * 80 * 2 + 8)
+#define LINE_BUF_PIXELS     (160 * 4)   // 4 linhas completas por transação
+#define MEM_LINES           162         // Linhas da memória do controlador (132x162)
 
 static spi_device_handle_t spi = NULL;
 static int dc_pin = -1;
@@ -23,8 +26,22 @@ static uint8_t colstart = 1;
 static uint8_t rowstart = 26;
 static uint16_t display_width = ST7735_WIDTH;
 static uint16_t display_height = ST7735_HEIGHT;
+static uint8_t display_rotation = 1;
 
-static const uint8_t font5x7[96 * 5] = {
+// Área de scroll vertical (em linhas de memória) e deslocamento atual
+static uint16_t scroll_tfa = 0;
+static uint16_t scroll_vsa = 0;
+static uint16_t scroll_off = 0;
+
+// Região de recorte (limites inclusivos, sempre dentro do ecrã)
+static int16_t clip_x0 = 0, clip_y0 = 0;
+static int16_t clip_x1 = ST7735_WIDTH - 1, clip_y1 = ST7735_HEIGHT - 1;
+
+// Dois buffers DMA alternados: um é preenchido enquanto o outro é transmitido
+static uint8_t *line_buf[2] = { NULL, NULL };
+
+// Fonte 5x7 (ASCII 32-127), declarada em st7735.h
+const uint8_t st7735_font5x7[96 * 5] = {
     0x00,0x00,0x00,0x00,0x00, 0x00,0x00,0x5F,0x00,0x00,
     0x00,0x07,0x00,0x07,0x00, 0x14,0x7F,0x14,0x7F,0x14,
     0x24,0x2A,0x7F,0x2A,0x12, 0x23,0x13,0x08,0x64,0x62,
@@ -105,6 +122,75 @@ static void set_address_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y
     write_command(ST7735_RAMWR);
 }
 
+// Recorta (x, y, w, h) à região de recorte; false se nada fica visível.
+// As contas são feitas em 32 bits para que x + w não transborde.
+static bool clip_rect(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                      uint16_t *cx, uint16_t *cy, uint16_t *cw, uint16_t *ch) {
+    if (w == 0 || h == 0) return false;
+    int32_t x0 = x, y0 = y;
+    int32_t x1 = x0 + w - 1, y1 = y0 + h - 1;
+    if (x0 > clip_x1 || y0 > clip_y1 || x1 < clip_x0 || y1 < clip_y0) return false;
+    if (x0 < clip_x0) x0 = clip_x0;
+    if (y0 < clip_y0) y0 = clip_y0;
+    if (x1 > clip_x1) x1 = clip_x1;
+    if (y1 > clip_y1) y1 = clip_y1;
+    *cx = x0; *cy = y0;
+    *cw = x1 - x0 + 1; *ch = y1 - y0 + 1;
+    return true;
+}
+
+void st7735_set_clip_rect(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    uint16_t cx, cy, cw, ch;
+    st7735_reset_clip_rect();
+    if (!clip_rect(x, y, w, h, &cx, &cy, &cw, &ch)) {
+        // Região vazia: limites invertidos rejeitam todas as primitivas
+        clip_x0 = 1; clip_x1 = 0;
+        return;
+    }
+    clip_x0 = cx; clip_y0 = cy;
+    clip_x1 = cx + cw - 1; clip_y1 = cy + ch - 1;
+}
+
+void st7735_reset_clip_rect(void) {
+    clip_x0 = 0; clip_y0 = 0;
+    clip_x1 = display_width - 1; clip_y1 = display_height - 1;
+}
+
+void st7735_get_clip_rect(int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1) {
+    *x0 = clip_x0; *y0 = clip_y0;
+    *x1 = clip_x1; *y1 = clip_y1;
+}
+
+void st7735_stream_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, st7735_row_cb_t cb, void *ctx) {
+    uint16_t cx, cy, cw, ch;
+    if (!clip_rect(x, y, w, h, &cx, &cy, &cw, &ch)) return;
+    if (!line_buf[0]) { ESP_LOGE(TAG, "Driver nao inicializado"); return; }
+    
+    set_address_window(cx, cy, cx + cw - 1, cy + ch - 1);
+    gpio_set_level(dc_pin, 1);
+    
+    // Gera o bloco seguinte enquanto o anterior segue por DMA; no máximo uma
+    // transação fica pendente, por isso o buffer a preencher está sempre livre
+    spi_transaction_t trans[2];
+    spi_transaction_t *done;
+    uint16_t rows_per_chunk = LINE_BUF_PIXELS / cw;
+    bool pending = false;
+    int cur = 0;
+    for (uint16_t row = 0; row < ch; ) {
+        uint16_t n = (ch - row < rows_per_chunk) ? ch - row : rows_per_chunk;
+        uint8_t *buf = line_buf[cur];
+        for (uint16_t i = 0; i < n; i++) cb(buf + i * cw * 2, cx, cy + row + i, cw, ctx);
+        
+        if (pending) spi_device_get_trans_result(spi, &done, portMAX_DELAY);
+        trans[cur] = (spi_transaction_t){ .length = n * cw * 16, .tx_buffer = buf };
+        spi_device_queue_trans(spi, &trans[cur], portMAX_DELAY);
+        pending = true;
+        cur ^= 1;
+        row += n;
+    }
+    if (pending) spi_device_get_trans_result(spi, &done, portMAX_DELAY);
+}
+
 esp_err_t st7735_init(const st7735_config_t *cfg) {
     esp_err_t ret;
     dc_pin = cfg->dc_io_num;
@@ -149,6 +235,14 @@ esp_err_t st7735_init(const st7735_config_t *cfg) {
     }
     ESP_LOGI(TAG, "SPI @ %d MHz", SPI_CLOCK_SPEED_HZ / 1000000);
     
+    for (int i = 0; i < 2; i++) {
+        if (!line_buf[i]) line_buf[i] = heap_caps_malloc(LINE_BUF_PIXELS * 2, MALLOC_CAP_DMA);
+        if (!line_buf[i]) {
+            ESP_LOGE(TAG, "DMA malloc falhou para buffer de linha");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
     gpio_set_level(rst_pin, 1); vTaskDelay(pdMS_TO_TICKS(50));
     gpio_set_level(rst_pin, 0); vTaskDelay(pdMS_TO_TICKS(100));
     gpio_set_level(rst_pin, 1); vTaskDelay(pdMS_TO_TICKS(200));
@@ -174,7 +268,8 @@ esp_err_t st7735_init(const st7735_config_t *cfg) {
     write_command(ST7735_INVON);
     
     write_command(ST7735_MADCTL); write_data_byte(0x78);
-    colstart = 1; rowstart = 26; display_width = 160; display_height = 80;
+    colstart = 1; rowstart = 26; display_width = 160; display_height = 80; display_rotation = 1;
+    st7735_reset_clip_rect();
     
     write_command(ST7735_COLMOD); write_data_byte(0x05);
     
@@ -190,24 +285,28 @@ esp_err_t st7735_init(const st7735_config_t *cfg) {
     return ESP_OK;
 }
 
-void st7735_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    if (x >= display_width || y >= display_height) return;
-    if (x + w > display_width) w = display_width - x;
-    if (y + h > display_height) h = display_height - y;
+void st7735_fill_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    uint16_t cx, cy, cw, ch;
+    if (!clip_rect(x, y, w, h, &cx, &cy, &cw, &ch)) return;
+    if (!line_buf[0]) { ESP_LOGE(TAG, "Driver nao inicializado"); return; }
     
-    set_address_window(x, y, x + w - 1, y + h - 1);
-    size_t line_size = w * 2;
-    uint8_t *buffer = heap_caps_malloc(line_size, MALLOC_CAP_DMA);
-    if (!buffer) { ESP_LOGE(TAG, "DMA malloc falhou"); return; }
+    set_address_window(cx, cy, cx + cw - 1, cy + ch - 1);
     
+    // Todos os pixels são iguais: preenche o buffer uma vez e reenvia-o
+    uint32_t total = (uint32_t)cw * ch;
+    uint32_t chunk = (total < LINE_BUF_PIXELS) ? total : LINE_BUF_PIXELS;
+    uint8_t *buffer = line_buf[0];
     uint8_t hi = color >> 8, lo = color & 0xFF;
-    for (size_t i = 0; i < w; i++) { buffer[i*2] = hi; buffer[i*2+1] = lo; }
-    for (uint16_t i = 0; i < h; i++) write_data(buffer, line_size);
-    heap_caps_free(buffer);
+    for (uint32_t i = 0; i < chunk; i++) { buffer[i*2] = hi; buffer[i*2+1] = lo; }
+    while (total) {
+        uint32_t n = (total < chunk) ? total : chunk;
+        write_data(buffer, n * 2);
+        total -= n;
+    }
 }
 
-void st7735_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
-    if (x >= display_width || y >= display_height) return;
+void st7735_draw_pixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < clip_x0 || x > clip_x1 || y < clip_y0 || y > clip_y1) return;
     set_address_window(x, y, x, y);
     uint8_t data[2] = { color >> 8, color & 0xFF };
     write_data(data, 2);
@@ -217,6 +316,25 @@ void st7735_fill_screen(uint16_t color) {
     st7735_fill_rect(0, 0, display_width, display_height, color);
 }
 
+static void write_scroll_start(uint16_t line) {
+    uint8_t data[2] = { line >> 8, line & 0xFF };
+    write_command(ST7735_VSCSAD);
+    write_data(data, 2);
+}
+
+static void write_scroll_area(uint16_t tfa, uint16_t vsa) {
+    uint16_t bfa = MEM_LINES - tfa - vsa;
+    uint8_t data[6] = { tfa >> 8, tfa & 0xFF, vsa >> 8, vsa & 0xFF, bfa >> 8, bfa & 0xFF };
+    write_command(ST7735_VSCRDEF);
+    write_data(data, 6);
+    write_scroll_start(tfa);
+}
+
+// Linha lógica (rotação 0/2) -> linha da memória; com MY=1 (rotação 2) a ordem inverte
+static uint16_t row_to_mem_line(int16_t y) {
+    return (display_rotation == 0) ? y + rowstart : MEM_LINES - 1 - (y + rowstart);
+}
+
 void st7735_set_rotation(uint8_t rotation) {
     uint8_t madctl;
     switch (rotation % 4) {
@@ -228,63 +346,181 @@ void st7735_set_rotation(uint8_t rotation) {
     }
     write_command(ST7735_MADCTL);
     write_data_byte(madctl);
+    display_rotation = rotation % 4;
+    st7735_reset_clip_rect();
+    if (scroll_vsa) {
+        // A faixa de scroll não sobrevive à mudança de orientação
+        write_scroll_area(0, MEM_LINES);
+        scroll_tfa = 0; scroll_vsa = 0; scroll_off = 0;
+    }
+}
+
+uint8_t st7735_get_rotation(void) { return display_rotation; }
+
+esp_err_t st7735_set_scroll_area(int16_t y, uint16_t h) {
+    // O scroll do controlador atua sobre as linhas da memória, que só
+    // coincidem com as linhas do ecrã nas rotações portrait
+    if (display_rotation != 0 && display_rotation != 2) return ESP_ERR_NOT_SUPPORTED;
+    if (h == 0) {
+        write_scroll_area(0, MEM_LINES);
+        scroll_tfa = 0; scroll_vsa = 0; scroll_off = 0;
+        return ESP_OK;
+    }
+    if (y < 0 || y + h > display_height) return ESP_ERR_INVALID_ARG;
+    uint16_t a = row_to_mem_line(y), b = row_to_mem_line(y + h - 1);
+    scroll_tfa = (a < b) ? a : b;
+    scroll_vsa = h;
+    scroll_off = 0;
+    write_scroll_area(scroll_tfa, scroll_vsa);
+    return ESP_OK;
+}
+
+int16_t st7735_scroll_advance(void) {
+    if (!scroll_vsa) return -1;
+    // A linha que estava no início da área passa para o fim: é a que deve ser redesenhada
+    uint16_t line = scroll_tfa + scroll_off;
+    scroll_off = (scroll_off + 1) % scroll_vsa;
+    write_scroll_start(scroll_tfa + scroll_off);
+    return (display_rotation == 0) ? line - rowstart : MEM_LINES - 1 - line - rowstart;
 }
 
 void st7735_invert_display(bool invert) {
     write_command(invert ? ST7735_INVON : ST7735_INVOFF);
 }
 
-void st7735_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (c < 32 || c > 127) c = '?';
-    uint8_t idx = c - 32;
+typedef struct {
+    int16_t x0, y0;
+    const char *str;
+    uint16_t len;
+    uint8_t cell;              // Largura de cada carácter antes da escala (5 ou 6 com espaço)
+    uint8_t size;
+    uint16_t color, bg;
+} text_ctx_t;
+
+// Linha `row` de um glifo 5x7 como bitmap 1-bpp (coluna 0 no bit mais alto)
+static uint8_t glyph_row_bits(char c, uint8_t row) {
+    // char pode ter sinal: compara o código como byte sem sinal
+    uint8_t code = (uint8_t)c;
+    if (code < 32 || code > 127) code = '?';
+    const uint8_t *glyph = &st7735_font5x7[(code - 32) * 5];
+    uint8_t bits = 0;
     for (uint8_t col = 0; col < 5; col++) {
-        uint8_t line = font5x7[idx * 5 + col];
-        for (uint8_t row = 0; row < 7; row++) {
-            uint16_t px = (line & (1 << row)) ? color : bg;
-            if (size == 1) st7735_draw_pixel(x + col, y + row, px);
-            else st7735_fill_rect(x + col*size, y + row*size, size, size, px);
-        }
+        if (glyph[col] & (1 << row)) bits |= 0x80 >> col;
     }
+    return bits;
 }
 
-void st7735_draw_string(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
-    uint16_t cx = x;
-    while (*str) {
-        if (*str == '\n') { y += 8 * size; cx = x; }
-        else { st7735_draw_char(cx, y, *str, color, bg, size); cx += 6 * size; }
-        str++;
+static void text_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const text_ctx_t *t = ctx;
+    uint8_t row = (y - t->y0) / t->size;
+    uint16_t seg = t->cell * t->size;
+    uint16_t px = x - t->x0;
+    while (count) {
+        // Expande o troço visível do carácter atual com o mesmo kernel dos bitmaps
+        uint16_t k = px / seg, off = px % seg;
+        uint16_t n = seg - off;
+        if (n > count) n = count;
+        uint8_t bits = (k < t->len) ? glyph_row_bits(t->str[k], row) : 0;
+        st7735_expand_1bpp_row(buf, &bits, off, n, t->size, t->color, t->bg);
+        buf += n * 2;
+        px += n;
+        count -= n;
     }
 }
 
+void st7735_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (size == 0) return;
+    text_ctx_t t = { .x0 = x, .y0 = y, .str = &c, .len = 1, .cell = 5, .size = size, .color = color, .bg = bg };
+    st7735_stream_rect(x, y, 5 * size, 7 * size, text_row, &t);
+}
 
+void st7735_draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
+    if (size == 0) return;
+    // Cada linha de texto é enviada numa única janela, incluindo os espaços entre caracteres
+    while (*str) {
+        const char *end = str;
+        while (*end && *end != '\n') end++;
+        uint16_t len = end - str;
+        if (len) {
+            text_ctx_t t = { .x0 = x, .y0 = y, .str = str, .len = len, .cell = 6, .size = size, .color = color, .bg = bg };
+            st7735_stream_rect(x, y, (len * 6 - 1) * size, 7 * size, text_row, &t);
+        }
+        if (!*end) break;
+        y += 8 * size;
+        str = end + 1;
+    }
+}
 
 uint16_t st7735_get_width(void) { return display_width; }
 uint16_t st7735_get_height(void) { return display_height; }
 
-void st7735_draw_image(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data) {
-    if (x >= display_width || y >= display_height) return;
-    if (x + w > display_width) w = display_width - x;
-    if (y + h > display_height) h = display_height - y;
-    
-    set_address_window(x, y, x + w - 1, y + h - 1);
-    
-    // Buffer para uma linha da imagem
-    size_t line_size = w * 2;
-    uint8_t *buffer = heap_caps_malloc(line_size, MALLOC_CAP_DMA);
-    if (!buffer) { 
-        ESP_LOGE(TAG, "DMA malloc falhou para imagem"); 
-        return; 
-    }
-    
-    // Enviar linha por linha
-    for (uint16_t row = 0; row < h; row++) {
-        for (uint16_t col = 0; col < w; col++) {
-            uint16_t pixel = data[row * w + col];
-            buffer[col * 2] = pixel >> 8;      // High byte
-            buffer[col * 2 + 1] = pixel & 0xFF; // Low byte
-        }
-        write_data(buffer, line_size);
+typedef struct {
+    int16_t x0, y0;
+    uint16_t stride;           // Em pixels (RGB) ou bytes (bitmaps)
+    const void *data;
+    uint16_t fg, bg;
+    const uint16_t *palette;
+} image_ctx_t;
+
+static void rgb565_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const image_ctx_t *img = ctx;
+    const uint16_t *src = (const uint16_t *)img->data + (y - img->y0) * img->stride + (x - img->x0);
+    for (uint16_t i = 0; i < count; i++) {
+        buf[i*2] = src[i] >> 8;        // High byte
+        buf[i*2+1] = src[i] & 0xFF;    // Low byte
     }
-    
-    heap_caps_free(buffer);
+}
+
+static void rgb888_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const image_ctx_t *img = ctx;
+    const uint8_t *src = (const uint8_t *)img->data + ((y - img->y0) * img->stride + (x - img->x0)) * 3;
+    st7735_rgb888_to_rgb565_row(buf, src, count, x, y);
+}
+
+static void argb8888_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const image_ctx_t *img = ctx;
+    const uint32_t *src = (const uint32_t *)img->data + (y - img->y0) * img->stride + (x - img->x0);
+    st7735_argb8888_to_rgb565_row(buf, src, count, x, y, img->bg);
+}
+
+void st7735_draw_image(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data) {
+    if (!data) return;
+    image_ctx_t img = { .x0 = x, .y0 = y, .stride = w, .data = data };
+    st7735_stream_rect(x, y, w, h, rgb565_row, &img);
+}
+
+void st7735_draw_image_rgb888(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data) {
+    if (!data) return;
+    image_ctx_t img = { .x0 = x, .y0 = y, .stride = w, .data = data };
+    st7735_stream_rect(x, y, w, h, rgb888_row, &img);
+}
+
+void st7735_draw_image_argb8888(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint32_t *data, uint16_t bg) {
+    if (!data) return;
+    image_ctx_t img = { .x0 = x, .y0 = y, .stride = w, .data = data, .bg = bg };
+    st7735_stream_rect(x, y, w, h, argb8888_row, &img);
+}
+
+static void bitmap_1bpp_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const image_ctx_t *img = ctx;
+    const uint8_t *src = (const uint8_t *)img->data + (y - img->y0) * img->stride;
+    st7735_expand_1bpp_row(buf, src, x - img->x0, count, 1, img->fg, img->bg);
+}
+
+static void bitmap_2bpp_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const image_ctx_t *img = ctx;
+    const uint8_t *src = (const uint8_t *)img->data + (y - img->y0) * img->stride;
+    st7735_expand_2bpp_row(buf, src, x - img->x0, count, img->palette);
+}
+
+void st7735_draw_bitmap_1bpp(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data, uint16_t fg, uint16_t bg) {
+    if (!data) return;
+    image_ctx_t img = { .x0 = x, .y0 = y, .stride = (w + 7) / 8, .data = data, .fg = fg, .bg = bg };
+    st7735_stream_rect(x, y, w, h, bitmap_1bpp_row, &img);
+}
+
+void st7735_draw_bitmap_2bpp(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *data, const uint16_t *palette) {
+    if (!data || !palette) return;
+    image_ctx_t img = { .x0 = x, .y0 = y, .stride = (w + 3) / 4, .data = data, .palette = palette };
+    st7735_stream_rect(x, y, w, h, bitmap_2bpp_row, &img);
 }
@@ -0,0 +1,102 @@
+/**
+ * @file st7735_color.c
+ * @brief Conversão RGB888/ARGB8888 -> RGB565 com dithering ordenado (Bayer 4x4)
+ */
+
+#include <stdbool.h>
+#include "st7735_color.h"
+
+// Matriz de Bayer 4x4 já escalada para o passo de quantização de cada canal:
+// 5 bits (R/B) perdem 3 bits -> limiar 0..7; 6 bits (G) perdem 2 -> limiar 0..3
+static const uint8_t bayer_rb[4][4] = {
+    { 0, 4, 1, 5 }, { 6, 2, 7, 3 }, { 1, 5, 0, 4 }, { 7, 3, 6, 2 },
+};
+static const uint8_t bayer_g[4][4] = {
+    { 0, 2, 0, 2 }, { 3, 1, 3, 1 }, { 0, 2, 0, 2 }, { 3, 1, 3, 1 },
+};
+
+// Reduz 0..255 para 0..248 (R/B) ou 0..252 (G) antes de somar o limiar,
+// para que a soma nunca ultrapasse 255 e não seja preciso saturar
+static inline uint16_t quantize(uint8_t r, uint8_t g, uint8_t b, uint8_t t_rb, uint8_t t_g) {
+    uint8_t r5 = (uint8_t)(r - (r >> 5) + t_rb) >> 3;
+    uint8_t g6 = (uint8_t)(g - (g >> 6) + t_g) >> 2;
+    uint8_t b5 = (uint8_t)(b - (b >> 5) + t_rb) >> 3;
+    return (r5 << 11) | (g6 << 5) | b5;
+}
+
+// (a*b)/255 arredondado, sem divisão
+static inline uint8_t mul_div255(uint16_t v) {
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+static inline uint8_t blend(uint8_t fg, uint8_t bg, uint8_t a) {
+    return mul_div255(fg * a + bg * (255 - a));
+}
+
+void st7735_rgb888_to_rgb565_row(uint8_t *dst, const uint8_t *src, uint16_t count, uint16_t x, uint16_t y) {
+    const uint8_t *t_rb = bayer_rb[y & 3];
+    const uint8_t *t_g = bayer_g[y & 3];
+    for (uint16_t i = 0; i < count; i++, src += 3) {
+        uint8_t k = (x + i) & 3;
+        uint16_t px = quantize(src[0], src[1], src[2], t_rb[k], t_g[k]);
+        dst[i*2] = px >> 8;
+        dst[i*2+1] = px & 0xFF;
+    }
+}
+
+void st7735_argb8888_to_rgb565_row(uint8_t *dst, const uint32_t *src, uint16_t count,
+                                   uint16_t x, uint16_t y, uint16_t bg) {
+    const uint8_t *t_rb = bayer_rb[y & 3];
+    const uint8_t *t_g = bayer_g[y & 3];
+    uint8_t bg_hi = bg >> 8, bg_lo = bg & 0xFF;
+
+    uint8_t bg_rgb[3];
+    st7735_rgb565_to_rgb888(bg, bg_rgb);
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t p = src[i];
+        uint8_t a = p >> 24;
+        if (a == 0) {
+            // Totalmente transparente: o fundo já está em RGB565, sem dithering
+            dst[i*2] = bg_hi;
+            dst[i*2+1] = bg_lo;
+            continue;
+        }
+        uint8_t r = (p >> 16) & 0xFF, g = (p >> 8) & 0xFF, b = p & 0xFF;
+        if (a != 255) {
+            r = blend(r, bg_rgb[0], a);
+            g = blend(g, bg_rgb[1], a);
+            b = blend(b, bg_rgb[2], a);
+        }
+        uint8_t k = (x + i) & 3;
+        uint16_t px = quantize(r, g, b, t_rb[k], t_g[k]);
+        dst[i*2] = px >> 8;
+        dst[i*2+1] = px & 0xFF;
+    }
+}
+
+void st7735_expand_1bpp_row(uint8_t *dst, const uint8_t *bits, uint16_t first, uint16_t count,
+                            uint8_t scale, uint16_t fg, uint16_t bg) {
+    uint8_t fg_hi = fg >> 8, fg_lo = fg & 0xFF;
+    uint8_t bg_hi = bg >> 8, bg_lo = bg & 0xFF;
+    if (scale == 0) scale = 1;
+    uint16_t bit = first / scale;
+    uint8_t rep = first % scale;
+    for (uint16_t i = 0; i < count; i++) {
+        bool on = bits[bit >> 3] & (0x80 >> (bit & 7));
+        dst[i*2] = on ? fg_hi : bg_hi;
+        dst[i*2+1] = on ? fg_lo : bg_lo;
+        if (++rep == scale) { rep = 0; bit++; }
+    }
+}
+
+void st7735_expand_2bpp_row(uint8_t *dst, const uint8_t *bits, uint16_t first, uint16_t count,
+                            const uint16_t *palette) {
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t p = first + i;
+        uint16_t c = palette[(bits[p >> 2] >> (6 - 2 * (p & 3))) & 0x03];
+        dst[i*2] = c >> 8;
+        dst[i*2+1] = c & 0xFF;
+    }
+}
@@ -0,0 +1,180 @@
+/**
+ * @file strip_chart.c
+ * @brief Gráfico de tira incremental (uma coluna/linha por amostra)
+ */
+
+#include <stdlib.h>
+#include "strip_chart.h"
+
+// Traço de uma amostra: segmento entre a posição da amostra anterior e a atual
+typedef struct {
+    const strip_chart_t *chart;
+    int16_t lo, hi;            // Extremos do segmento (linhas no sweep, colunas no scroll)
+    int16_t col;               // Coluna desenhada (só no sweep)
+} trace_ctx_t;
+
+static inline void put_px(uint8_t *buf, uint16_t i, uint16_t color) {
+    buf[i*2] = color >> 8;
+    buf[i*2+1] = color & 0xFF;
+}
+
+static int16_t clamp_value(const strip_chart_config_t *cfg, int16_t v) {
+    if (v < cfg->min) return cfg->min;
+    if (v > cfg->max) return cfg->max;
+    return v;
+}
+
+// Posição do valor no eixo dos valores, em coordenadas do ecrã
+static int16_t value_pos(const strip_chart_t *chart, int16_t v) {
+    const strip_chart_config_t *cfg = &chart->cfg;
+    int32_t range = (int32_t)cfg->max - cfg->min;
+    int32_t off = (int32_t)clamp_value(cfg, v) - cfg->min;
+    if (cfg->mode == STRIP_CHART_SWEEP) return cfg->y + (cfg->h - 1) - off * (cfg->h - 1) / range;
+    return cfg->x + off * (cfg->w - 1) / range;
+}
+
+// Índice da amostra mostrada no slot k (0 = mais antigo), ou -1 se vazio
+static int32_t slot_sample(const strip_chart_t *chart, uint16_t k) {
+    uint16_t i = (chart->head + k) % chart->capacity;
+    return (chart->count == chart->capacity || i < chart->count) ? i : -1;
+}
+
+// Extremos do traço do slot k; false se o slot não tem amostra
+static bool slot_trace(const strip_chart_t *chart, uint16_t k, int16_t *lo, int16_t *hi) {
+    int32_t i = slot_sample(chart, k);
+    if (i < 0) return false;
+    int16_t a = value_pos(chart, chart->samples[i]);
+    int16_t b = a;
+    int32_t p = (k > 0) ? slot_sample(chart, k - 1) : -1;
+    if (p >= 0) b = value_pos(chart, chart->samples[p]);
+    *lo = (a < b) ? a : b;
+    *hi = (a > b) ? a : b;
+    return true;
+}
+
+static void sweep_column_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const trace_ctx_t *t = ctx;
+    const strip_chart_config_t *cfg = &t->chart->cfg;
+    bool on = (y >= t->lo && y <= t->hi);
+    for (uint16_t i = 0; i < count; i++) {
+        put_px(buf, i, (on && x + i == t->col) ? cfg->color : cfg->bg);
+    }
+}
+
+static void scroll_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const trace_ctx_t *t = ctx;
+    const strip_chart_config_t *cfg = &t->chart->cfg;
+    for (uint16_t i = 0; i < count; i++) {
+        put_px(buf, i, (x + i >= t->lo && x + i <= t->hi) ? cfg->color : cfg->bg);
+    }
+}
+
+static void sweep_redraw_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const strip_chart_t *chart = ctx;
+    const strip_chart_config_t *cfg = &chart->cfg;
+    for (uint16_t i = 0; i < count; i++) {
+        // A coluna c guarda a amostra c; a coluna "head" é o intervalo vazio
+        uint16_t c = x + i - cfg->x;
+        uint16_t k = (c + chart->capacity - chart->head) % chart->capacity;
+        int16_t lo, hi;
+        bool on = k > 0 && slot_trace(chart, k, &lo, &hi) && y >= lo && y <= hi;
+        put_px(buf, i, on ? cfg->color : cfg->bg);
+    }
+}
+
+static void scroll_redraw_row(uint8_t *buf, uint16_t x, uint16_t y, uint16_t count, void *ctx) {
+    const strip_chart_t *chart = ctx;
+    const strip_chart_config_t *cfg = &chart->cfg;
+    // Rotação 0: o mais antigo está no topo; rotação 2: no fundo
+    uint16_t k = (st7735_get_rotation() == 0) ? y - cfg->y : cfg->y + cfg->h - 1 - y;
+    int16_t lo, hi;
+    if (!slot_trace(chart, k, &lo, &hi)) { lo = 1; hi = 0; }
+    trace_ctx_t t = { .chart = chart, .lo = lo, .hi = hi };
+    scroll_row(buf, x, y, count, &t);
+}
+
+esp_err_t strip_chart_init(strip_chart_t *chart, const strip_chart_config_t *cfg) {
+    if (!chart || !cfg || cfg->w == 0 || cfg->h == 0 || cfg->max <= cfg->min) return ESP_ERR_INVALID_ARG;
+    chart->cfg = *cfg;
+    chart->capacity = (cfg->mode == STRIP_CHART_SWEEP) ? cfg->w : cfg->h;
+    chart->head = 0;
+    chart->count = 0;
+    chart->samples = NULL;
+
+    if (cfg->mode == STRIP_CHART_SCROLL) {
+        esp_err_t ret = st7735_set_scroll_area(cfg->y, cfg->h);
+        if (ret != ESP_OK) return ret;
+    }
+    chart->samples = malloc(chart->capacity * sizeof(int16_t));
+    if (!chart->samples) {
+        if (cfg->mode == STRIP_CHART_SCROLL) st7735_set_scroll_area(0, 0);
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t ret = strip_chart_redraw(chart);
+    if (ret != ESP_OK) strip_chart_deinit(chart);
+    return ret;
+}
+
+void strip_chart_push(strip_chart_t *chart, int16_t value) {
+    if (!chart->samples) return;
+    const strip_chart_config_t *cfg = &chart->cfg;
+    uint16_t prev = (chart->head + chart->capacity - 1) % chart->capacity;
+    int16_t a = value_pos(chart, value);
+    int16_t b = (chart->count > 0) ? value_pos(chart, chart->samples[prev]) : a;
+    trace_ctx_t t = { .chart = chart, .lo = (a < b) ? a : b, .hi = (a > b) ? a : b };
+
+    uint16_t pos = chart->head;
+    bool full = chart->count == chart->capacity;
+    chart->samples[pos] = value;
+    chart->head = (pos + 1) % chart->capacity;
+    if (!full) chart->count++;
+
+    if (cfg->mode == STRIP_CHART_SCROLL) {
+        int16_t row = st7735_scroll_advance();
+        if (row < 0) return;
+        st7735_stream_rect(cfg->x, row, cfg->w, 1, scroll_row, &t);
+        if (full) {
+            // A amostra mais antiga perdeu a anterior: passa a ponto, como em
+            // strip_chart_redraw(). Fica na linha seguinte da memória (acima no
+            // ecrã na rotação 2)
+            int16_t oldest = (st7735_get_rotation() == 0) ? row + 1 : row - 1;
+            if (oldest >= cfg->y + cfg->h) oldest -= cfg->h;
+            if (oldest < cfg->y) oldest += cfg->h;
+            t.lo = t.hi = value_pos(chart, chart->samples[chart->head]);
+            st7735_stream_rect(cfg->x, oldest, cfg->w, 1, scroll_row, &t);
+        }
+        return;
+    }
+
+    // Coluna nova + coluna seguinte apagada (intervalo que marca o cursor)
+    t.col = cfg->x + pos;
+    if (chart->capacity == 1) {
+        st7735_stream_rect(t.col, cfg->y, 1, cfg->h, sweep_column_row, &t);
+    } else if (chart->head != 0) {
+        st7735_stream_rect(t.col, cfg->y, 2, cfg->h, sweep_column_row, &t);
+    } else {
+        st7735_stream_rect(t.col, cfg->y, 1, cfg->h, sweep_column_row, &t);
+        st7735_fill_rect(cfg->x, cfg->y, 1, cfg->h, cfg->bg);
+    }
+}
+
+esp_err_t strip_chart_redraw(strip_chart_t *chart) {
+    if (!chart->samples) return ESP_ERR_INVALID_STATE;
+    const strip_chart_config_t *cfg = &chart->cfg;
+    if (cfg->mode == STRIP_CHART_SCROLL) {
+        // Repõe o deslocamento para que a memória coincida com o ecrã
+        esp_err_t ret = st7735_set_scroll_area(cfg->y, cfg->h);
+        if (ret != ESP_OK) return ret;
+        st7735_stream_rect(cfg->x, cfg->y, cfg->w, cfg->h, scroll_redraw_row, chart);
+    } else {
+        st7735_stream_rect(cfg->x, cfg->y, cfg->w, cfg->h, sweep_redraw_row, chart);
+    }
+    return ESP_OK;
+}
+
+void strip_chart_deinit(strip_chart_t *chart) {
+    if (!chart->samples) return;
+    if (chart->cfg.mode == STRIP_CHART_SCROLL) st7735_set_scroll_area(0, 0);
+    free(chart->samples);
+    chart->samples = NULL;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file fake_panel.c
+ * @brief Controlador ST7735 emulado no host (ver fake_panel.h)
+ */
+
+#include <string.h>
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "freertos/task.h"
+#include "st7735.h"
+#include "fake_panel.h"
+
+#define MEM_COLS 162
+#define MEM_ROWS 162
+
+#define MADCTL_MY 0x80
+#define MADCTL_MV 0x20
+
+// Indexada pelos endereços de coluna/linha enviados em CASET/RASET
+static uint16_t mem[MEM_ROWS][MEM_COLS];
+static int dc_level;
+static uint8_t cmd, args[6], nargs;
+static uint8_t madctl = 0x78;   // Rotação 1, a do st7735_init
+static uint16_t scroll_tfa, scroll_vsa, scroll_start;
+static uint16_t col0, col1, row0, row1, col, row;
+static bool high_byte;
+static uint8_t pixel_hi;
+static uint32_t windows;
+
+// Transações enfileiradas (o driver deixa no máximo uma pendente)
+static spi_transaction_t *queue[4];
+static uint8_t queued;
+
+static void write_byte(uint8_t b) {
+    switch (cmd) {
+    case 0x2A:   // CASET
+    case 0x2B:   // RASET
+        if (nargs < 4) args[nargs++] = b;
+        if (nargs == 4) {
+            uint16_t a0 = args[0] << 8 | args[1], a1 = args[2] << 8 | args[3];
+            if (cmd == 0x2A) { col0 = a0; col1 = a1; }
+            else { row0 = a0; row1 = a1; }
+        }
+        break;
+    case 0x33:   // VSCRDEF
+        if (nargs < 6) args[nargs++] = b;
+        if (nargs == 6) {
+            scroll_tfa = args[0] << 8 | args[1];
+            scroll_vsa = args[2] << 8 | args[3];
+        }
+        break;
+    case 0x36:   // MADCTL
+        madctl = b;
+        break;
+    case 0x37:   // VSCSAD
+        if (nargs < 2) args[nargs++] = b;
+        if (nargs == 2) scroll_start = args[0] << 8 | args[1];
+        break;
+    case 0x2C:   // RAMWR
+        if (!high_byte) { pixel_hi = b; high_byte = true; break; }
+        high_byte = false;
+        if (row < MEM_ROWS && col < MEM_COLS) mem[row][col] = pixel_hi << 8 | b;
+        if (++col > col1) { col = col0; row++; }
+        break;
+    default:
+        break;
+    }
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+    const uint8_t *data = trans->tx_buffer;
+    size_t len = trans->length / 8;
+    if (dc_level == 0) {
+        cmd = data[0];
+        nargs = 0;
+        high_byte = false;
+        if (cmd == 0x2C) { col = col0; row = row0; windows++; }
+        return ESP_OK;
+    }
+    for (size_t i = 0; i < len; i++) write_byte(data[i]);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait) {
+    if (queued == sizeof(queue) / sizeof(queue[0])) return ESP_ERR_INVALID_STATE;
+    spi_device_polling_transmit(handle, trans);
+    queue[queued++] = trans;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait) {
+    if (queued == 0) return ESP_ERR_INVALID_STATE;
+    *trans = queue[0];
+    memmove(queue, queue + 1, --queued * sizeof(queue[0]));
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *cfg, int dma_chan) {
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *handle) {
+    *handle = (spi_device_handle_t)&mem;
+    return ESP_OK;
+}
+
+esp_err_t gpio_config(const gpio_config_t *cfg) {
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(int gpio_num, uint32_t level) {
+    // Só o pino DC interessa: os testes usam dc_io_num = 0
+    if (gpio_num == 0) dc_level = level;
+    return ESP_OK;
+}
+
+void vTaskDelay(TickType_t ticks) {
+}
+
+const char *esp_err_to_name(esp_err_t code) {
+    return "ERR";
+}
+
+void panel_clear(void) {
+    memset(mem, 0, sizeof(mem));
+    windows = 0;
+}
+
+// Linha da memória mostrada na linha física `line` do ecrã
+static uint16_t scrolled_line(uint16_t line) {
+    if (scroll_vsa == 0 || line < scroll_tfa || line >= scroll_tfa + scroll_vsa) return line;
+    return scroll_tfa + (scroll_start - scroll_tfa + line - scroll_tfa) % scroll_vsa;
+}
+
+uint16_t panel_pixel(int16_t x, int16_t y) {
+    // Deslocamentos iguais aos de st7735_set_rotation
+    if (madctl & MADCTL_MV) return mem[y + 26][x + 1];
+    // Em portrait o endereço de linha é a linha da memória (invertida com MY),
+    // onde atua o scroll
+    uint16_t addr = y + 1;
+    uint16_t line = (madctl & MADCTL_MY) ? MEM_ROWS - 1 - addr : addr;
+    line = scrolled_line(line);
+    addr = (madctl & MADCTL_MY) ? MEM_ROWS - 1 - line : line;
+    return mem[addr][x + 26];
+}
+
+uint32_t panel_count(uint16_t color) {
+    uint32_t n = 0;
+    for (int16_t y = 0; y < st7735_get_height(); y++) {
+        for (int16_t x = 0; x < st7735_get_width(); x++) n += panel_pixel(x, y) == color;
+    }
+    return n;
+}
+
+uint32_t panel_windows(void) {
+    return windows;
+}
@@ -0,0 +1,25 @@
+/**
+ * @file fake_panel.h
+ * @brief Controlador ST7735 emulado no host para os testes
+ *
+ * Implementa as funções de SPI/GPIO do stub do ESP-IDF e descodifica os
+ * comandos CASET/RASET/RAMWR para uma memória de ecrã, contando as janelas
+ * abertas (uma por RAMWR). MADCTL e o scroll vertical (VSCRDEF/VSCSAD) são
+ * seguidos para que panel_pixel() devolva o que o ecrã mostra.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** @brief Apaga a memória (fica a 0) e os contadores */
+void panel_clear(void);
+
+/** @brief Pixel (x, y) mostrado no ecrã, na rotação atual e com o scroll aplicado */
+uint16_t panel_pixel(int16_t x, int16_t y);
+
+/** @brief Número de pixels do ecrã com a cor indicada */
+uint32_t panel_count(uint16_t color);
+
+/** @brief Janelas (comandos RAMWR) desde o último panel_clear() */
+uint32_t panel_windows(void);
@@ -0,0 +1,15 @@
+// Stub mínimo do ESP-IDF para os testes de host
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#define GPIO_MODE_OUTPUT 2
+
+typedef struct {
+    uint64_t pin_bit_mask;
+    int mode;
+} gpio_config_t;
+
+esp_err_t gpio_config(const gpio_config_t *cfg);
+esp_err_t gpio_set_level(int gpio_num, uint32_t level);
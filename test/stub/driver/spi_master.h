@@ -0,0 +1,38 @@
+// Stub mínimo do ESP-IDF para os testes de host (implementado em fake_panel.c)
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int spi_host_device_t;
+typedef struct spi_device_t *spi_device_handle_t;
+
+#define SPI2_HOST            1
+#define SPI3_HOST            2
+#define SPI_DMA_CH_AUTO      3
+#define SPI_DEVICE_NO_DUMMY  (1 << 6)
+
+typedef struct {
+    uint32_t flags;
+    size_t length;             // Em bits
+    const void *tx_buffer;
+} spi_transaction_t;
+
+typedef struct {
+    int mosi_io_num, miso_io_num, sclk_io_num, quadwp_io_num, quadhd_io_num;
+    int max_transfer_sz;
+} spi_bus_config_t;
+
+typedef struct {
+    int clock_speed_hz, mode, spics_io_num, queue_size;
+    uint32_t flags;
+} spi_device_interface_config_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *cfg, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *handle);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait);
@@ -0,0 +1,9 @@
+// Stub mínimo do ESP-IDF para os testes de host
+#pragma once
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA (1 << 3)
+
+static inline void *heap_caps_malloc(size_t size, int caps) { (void)caps; return malloc(size); }
+static inline void heap_caps_free(void *ptr) { free(ptr); }
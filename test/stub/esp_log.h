@@ -0,0 +1,5 @@
+// Stub mínimo do ESP-IDF para os testes de host: registos descartados
+#pragma once
+
+#define ESP_LOGI(tag, ...) ((void)(tag))
+#define ESP_LOGE(tag, ...) ((void)(tag))
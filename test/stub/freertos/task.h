@@ -0,0 +1,6 @@
+// Stub mínimo do ESP-IDF para os testes de host
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+void vTaskDelay(TickType_t ticks);
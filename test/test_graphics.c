@@ -0,0 +1,145 @@
+/**
+ * @file test_graphics.c
+ * @brief Testes de host da rasterização de graphics.c sobre o painel emulado
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "st7735.h"
+#include "graphics.h"
+#include "fake_panel.h"
+
+#define ON ST7735_WHITE
+
+static int failures;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+} while (0)
+
+static void test_triangle_inclusive(void) {
+    // Tal como draw_filled_rect, inclui a aresta direita e a de baixo
+    panel_clear();
+    draw_filled_triangle(0, 0, 10, 0, 0, 10, ON);
+    CHECK(panel_count(ON) == 66);
+    CHECK(panel_pixel(10, 0) == ON);
+    CHECK(panel_pixel(0, 10) == ON);
+}
+
+static void test_triangle_one_row(void) {
+    panel_clear();
+    draw_filled_triangle(2, 5, 40, 5, 20, 5, ON);
+    CHECK(panel_count(ON) == 39);
+    for (int16_t x = 2; x <= 40; x++) CHECK(panel_pixel(x, 5) == ON);
+}
+
+static void test_triangle_zero_area(void) {
+    // Um triângulo de área nula tem de cobrir pelo menos o segmento
+    panel_clear();
+    draw_line(2, 5, 40, 9, ON);
+    uint16_t line[80][160];
+    for (int16_t y = 0; y < 80; y++) {
+        for (int16_t x = 0; x < 160; x++) line[y][x] = panel_pixel(x, y);
+    }
+    panel_clear();
+    draw_filled_triangle(2, 5, 40, 9, 2, 5, ON);
+    for (int16_t y = 0; y < 80; y++) {
+        for (int16_t x = 0; x < 160; x++) {
+            if (line[y][x] == ON) CHECK(panel_pixel(x, y) == ON);
+        }
+    }
+
+    panel_clear();
+    draw_filled_triangle(5, 5, 5, 5, 5, 5, ON);
+    CHECK(panel_count(ON) == 1);
+    CHECK(panel_pixel(5, 5) == ON);
+}
+
+static void test_needle_tip(void) {
+    // Agulha fina: a ponta não pode desaparecer
+    panel_clear();
+    draw_filled_triangle(2, 4, 40, 7, 2, 6, ON);
+    CHECK(panel_pixel(40, 7) == ON);
+    for (int16_t x = 2; x <= 40; x++) {
+        bool hit = false;
+        for (int16_t y = 4; y <= 7; y++) hit |= panel_pixel(x, y) == ON;
+        CHECK(hit);
+    }
+}
+
+static void test_aa_batching(void) {
+    // Agulha vertical: interior e arestas repetem-se linha a linha e juntam-se
+    // em poucos retângulos, em vez de uma janela por linha
+    panel_clear();
+    draw_thick_line_aa(20, 10, 20, 70, 6, ON, ST7735_BLACK);
+    CHECK(panel_windows() <= 8);
+    CHECK(panel_pixel(20, 40) == ON);
+    uint16_t edge = panel_pixel(17, 40);
+    CHECK(edge != ON && edge != ST7735_BLACK);
+    CHECK(panel_pixel(17, 41) == edge);
+
+    // Agulha diagonal: nenhuma linha se repete, mas continua uma janela por linha
+    panel_clear();
+    draw_thick_line_aa(80, 40, 130, 10, 4, ON, ST7735_BLACK);
+    CHECK(panel_windows() <= 40);
+}
+
+static void test_radial_large_radius(void) {
+    // Centro longe do ecrã: as distâncias passam de 4096 px (curva suave de fundo)
+    panel_clear();
+    fill_radial_gradient(0, 0, ST7735_WIDTH, ST7735_HEIGHT, -4900, 40, 5000, ST7735_BLACK, ST7735_WHITE);
+    // t = 4900/5000 à esquerda; o resto do ecrã continua até ao raio e além dele
+    uint16_t prev = 0;
+    for (int16_t x = 0; x < ST7735_WIDTH; x += 8) {
+        uint16_t red = panel_pixel(x, 40) >> 11;
+        CHECK(red >= 29);
+        CHECK(red >= prev);
+        prev = red;
+    }
+    CHECK(panel_pixel(ST7735_WIDTH - 1, 40) == ST7735_WHITE);
+}
+
+// Copia um retângulo do painel para comparar desenhos
+static void grab(uint16_t *dst, int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int16_t r = 0; r < h; r++) {
+        for (int16_t c = 0; c < w; c++) dst[r * w + c] = panel_pixel(x + c, y + r);
+    }
+}
+
+static void test_char_out_of_range(void) {
+    // Bytes >= 0x80 (UTF-8, Latin-1) são desenhados como '?', com ou sem fundo
+    uint16_t want[6 * 7], got[6 * 7];
+    for (int transparent = 0; transparent < 2; transparent++) {
+        uint16_t bg = transparent ? ON : ST7735_BLUE;
+        const char codes[] = { '?', (char)0x80, (char)0xC3, (char)0xFF, (char)0x1F };
+        for (unsigned i = 0; i < sizeof(codes); i++) {
+            panel_clear();
+            draw_char(10, 10, codes[i], ON, bg, 1);
+            grab(i ? got : want, 10, 10, 6, 7);
+            if (i) CHECK(memcmp(want, got, sizeof(want)) == 0);
+        }
+    }
+}
+
+int main(void) {
+    st7735_config_t cfg = { .dc_io_num = 0, .rst_io_num = 1, .bl_io_num = -1, .host_id = SPI2_HOST };
+    if (st7735_init(&cfg) != ESP_OK) {
+        printf("st7735_init falhou\n");
+        return 1;
+    }
+
+    test_triangle_inclusive();
+    test_triangle_one_row();
+    test_triangle_zero_area();
+    test_needle_tip();
+    test_aa_batching();
+    test_radial_large_radius();
+    test_char_out_of_range();
+
+    if (failures) {
+        printf("%d verificações falharam\n", failures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file test_strip_chart.c
+ * @brief Testes de host do gráfico de tira sobre o painel emulado
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "st7735.h"
+#include "strip_chart.h"
+#include "fake_panel.h"
+
+static int failures;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+} while (0)
+
+static const int16_t values[] = { 0, 1, 2, 3, 7, 7, 0, 4, 4, 4, 5, 6, 7, 6, 5, 4, 3, 2, 1, 0 };
+
+// Copia a área do gráfico tal como é mostrada
+static void grab(const strip_chart_config_t *cfg, uint16_t *dst) {
+    for (int16_t r = 0; r < cfg->h; r++) {
+        for (int16_t c = 0; c < cfg->w; c++) dst[r * cfg->w + c] = panel_pixel(cfg->x + c, cfg->y + r);
+    }
+}
+
+// O desenho incremental tem de coincidir com strip_chart_redraw() em qualquer momento
+static void check_push_matches_redraw(strip_chart_mode_t mode, uint8_t rotation) {
+    st7735_set_rotation(rotation);
+    strip_chart_config_t cfg = {
+        .x = 2, .y = 5, .w = 10, .h = 6, .min = 0, .max = 7,
+        .color = ST7735_WHITE, .bg = ST7735_BLUE, .mode = mode,
+    };
+    strip_chart_t chart;
+    CHECK(strip_chart_init(&chart, &cfg) == ESP_OK);
+
+    uint16_t pushed[10 * 6], redrawn[10 * 6];
+    for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        strip_chart_push(&chart, values[i]);
+        grab(&cfg, pushed);
+        CHECK(strip_chart_redraw(&chart) == ESP_OK);
+        grab(&cfg, redrawn);
+        if (memcmp(pushed, redrawn, sizeof(pushed)) != 0) {
+            printf("modo %d, rotação %d: push %u difere do redraw\n", mode, rotation, i);
+            failures++;
+        }
+    }
+    strip_chart_deinit(&chart);
+}
+
+int main(void) {
+    st7735_config_t cfg = { .dc_io_num = 0, .rst_io_num = 1, .bl_io_num = -1, .host_id = SPI2_HOST };
+    if (st7735_init(&cfg) != ESP_OK) {
+        printf("st7735_init falhou\n");
+        return 1;
+    }
+
+    check_push_matches_redraw(STRIP_CHART_SWEEP, 1);
+    check_push_matches_redraw(STRIP_CHART_SCROLL, 0);
+    check_push_matches_redraw(STRIP_CHART_SCROLL, 2);
+
+    if (failures) {
+        printf("%d verificações falharam\n", failures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}